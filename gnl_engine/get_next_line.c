@@ -0,0 +1,344 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:48:20 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 15:06:40 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Consumes the bytes the reader handed out on the last call, and
+ * forgets a read refused by the memory budget on the last call.
+ * @param gnl The reader.
+ */
+static void	gnl_release(t_gnl *gnl)
+{
+	if (gnl->held)
+		gnl_store_consume(&gnl->store, gnl->held);
+	gnl->held = 0;
+	gnl->refused = 0;
+}
+
+#if GNL_MULTI_FD
+
+/**
+ * @brief Returns the reader of a file descriptor as it is, without consuming
+ * what the previous call handed out (see gnl_unread).
+ * @param fd The file descriptor.
+ * @return The fd's slot in the reader table, or NULL if fd is out of range.
+ * @note The table is the only static variable of the engine.
+ */
+t_gnl	*gnl_slot(int fd)
+{
+	static t_gnl	readers[MAX_FD];
+
+	if (fd < 0 || fd >= MAX_FD)
+		return (NULL);
+	return (&readers[fd]);
+}
+
+#else
+
+/**
+ * @brief Returns the reader of a file descriptor as it is, without consuming
+ * what the previous call handed out (see gnl_unread).
+ * @param fd The file descriptor.
+ * @return The single reader, shared by every fd, or NULL if fd is negative.
+ */
+t_gnl	*gnl_slot(int fd)
+{
+	static t_gnl	reader;
+
+	if (fd < 0)
+		return (NULL);
+	return (&reader);
+}
+
+#endif
+
+/**
+ * @brief Returns the reader of a file descriptor, after consuming the line
+ * the previous call handed out.
+ * @param fd The file descriptor.
+ * @return The reader (see gnl_slot), or NULL if fd is out of range.
+ * @note With GNL_CHECK_REUSE, bytes left over by a closed fd, or by another fd
+ * sharing the single reader, are dropped here.
+ */
+t_gnl	*gnl_get(int fd)
+{
+	t_gnl	*gnl;
+
+	gnl = gnl_slot(fd);
+	if (!gnl)
+		return (NULL);
+	gnl_release(gnl);
+	GNL_CHECK_FD(gnl, fd);
+	return (gnl);
+}
+
+/**
+ * @brief Sizes the next read: BUFFER_SIZE or, with GNL_READV and after a read
+ * that filled all the room it was given, the bytes the fd has ready
+ * (FIONREAD), up to GNL_BURST_MAX. A burst is then taken in by one syscall,
+ * while a trickle costs no extra ioctl.
+ * @note Only pipes and sockets are asked: on a file FIONREAD is the bytes left
+ * to EOF, not a burst, and a source has no fd. What the fd is is looked up
+ * once per reader.
+ */
+static size_t	gnl_burst(t_gnl *gnl, int fd)
+{
+	struct stat	st;
+	int			ready;
+
+	if (!GNL_READV || !gnl->burst || gnl->source)
+		return (BUFFER_SIZE);
+	if (!gnl->stream)
+	{
+		gnl->stream = -1;
+		if (fstat(fd, &st) == 0
+			&& (S_ISFIFO(st.st_mode) || S_ISSOCK(st.st_mode)))
+			gnl->stream = 1;
+	}
+	if (gnl->stream < 0 || ioctl(fd, FIONREAD, &ready) == -1
+		|| ready <= BUFFER_SIZE)
+		return (BUFFER_SIZE);
+	if (ready > GNL_BURST_MAX)
+		return (GNL_BURST_MAX);
+	return (ready);
+}
+
+/**
+ * @brief Reads into the reserved space: from the reader's source if it has
+ * one (into the first part only), else from the fd.
+ * @note A read refused with EINVAL on a fd in direct mode (see
+ * gnl_set_direct) is retried once buffered.
+ */
+static ssize_t	gnl_read(t_gnl *gnl, int fd, struct iovec *iov, int n_iov)
+{
+	ssize_t	bytes_read;
+
+	if (gnl->source)
+		return (gnl->source->read(gnl->ctx, iov[0].iov_base, iov[0].iov_len));
+	bytes_read = readv(fd, iov, n_iov);
+	if (bytes_read == -1 && errno == EINVAL && gnl_direct_off(fd))
+		bytes_read = readv(fd, iov, n_iov);
+	return (bytes_read);
+}
+
+/**
+ * @brief Reads once from the fd straight into the free space of the store,
+ * with readv when that space is in two parts (wrapped ring, end of the last
+ * chunk and a spare chunk), or from the reader's source if it has one (see
+ * gnl_open_source).
+ * @param gnl The reader.
+ * @param fd The file descriptor to read from.
+ * @return The number of bytes read, 0 at EOF, -1 on read error or memory
+ * allocation failure, or if the memory budget refuses the read (errno is
+ * ENOBUFS or EMSGSIZE, gnl->refused is set and nothing is read). A non-blocking fd with
+ * nothing ready (errno is EAGAIN) also sets gnl->refused.
+ * @note The page cache policies of the reader (see gnl_set_cache) are applied
+ * after each read.
+ */
+ssize_t	gnl_fill(t_gnl *gnl, int fd)
+{
+	struct iovec	iov[2];
+	int				n_iov;
+	size_t			room;
+	ssize_t			bytes_read;
+	uint64_t		t;
+
+	if (gnl->source && !gnl->source->read)
+		return (0);
+	n_iov = gnl_store_reserve_iov(&gnl->store, iov, gnl_burst(gnl, fd));
+	if (!n_iov)
+		return (-1);
+	room = iov[0].iov_len;
+	if (n_iov == 2)
+		room += iov[1].iov_len;
+	gnl->refused = GNL_BUDGET_REFUSES(gnl_store_len(&gnl->store), room);
+	if (gnl->refused)
+		return (errno = gnl->refused, -1);
+	GNL_NOTE_FD(gnl, fd);
+	GNL_STAT_START(t);
+	bytes_read = gnl_read(gnl, fd, iov, n_iov);
+	GNL_STAT_STOP(GNL_PHASE_READ, t);
+	gnl->burst = (bytes_read == (ssize_t)room);
+	gnl->suspect = !gnl->burst;
+	gnl->refused = (bytes_read == -1
+			&& (errno == EAGAIN || errno == EWOULDBLOCK));
+	if (bytes_read > 0)
+		gnl_store_commit(&gnl->store, bytes_read);
+	if (bytes_read >= 0 && gnl->cache.policy)
+		gnl_cache_step(gnl, fd, bytes_read);
+	return (bytes_read);
+}
+
+/**
+ * @brief Reads until the store holds a complete line.
+ * @param gnl The reader.
+ * @param fd The file descriptor to read from.
+ * @return
+ * - The length of the next line, newline included.
+ *
+ * - The number of pending bytes if EOF comes before a newline (0 if none).
+ *
+ * - -1 on read error or memory allocation failure.
+ * @note Bytes already scanned are not scanned again after each read.
+ */
+ssize_t	gnl_line_len(t_gnl *gnl, int fd)
+{
+	ssize_t		i_nl;
+	size_t		scanned;
+	ssize_t		bytes_read;
+	uint64_t	t;
+
+	scanned = 0;
+	while (1)
+	{
+		GNL_STAT_START(t);
+		i_nl = gnl_store_find(&gnl->store, scanned, '\n');
+		GNL_STAT_STOP(GNL_PHASE_SCAN, t);
+		if (i_nl >= 0)
+			return (i_nl + 1);
+		scanned = gnl_store_len(&gnl->store);
+		bytes_read = gnl_fill(gnl, fd);
+		if (bytes_read == -1)
+			return (-1);
+		if (bytes_read == 0)
+			return (scanned);
+	}
+}
+
+/**
+ * @brief Copies the first bytes of the store into a new string.
+ * @param gnl The reader.
+ * @param len The number of bytes to copy.
+ * @return The null-terminated string, or NULL if memory allocation fails.
+ */
+static char	*gnl_dup(t_gnl *gnl, size_t len)
+{
+	char		*line;
+	uint64_t	t;
+
+	GNL_STAT_START(t);
+	line = (char *)malloc((len + 1) * sizeof(char));
+	if (!line)
+		return (NULL);
+	gnl_store_copy(&gnl->store, line, len);
+	line[len] = '\0';
+	GNL_STAT_STOP(GNL_PHASE_COPY, t);
+	return (line);
+}
+
+/**
+ * @brief Copies the first bytes of the store into a new string and consumes
+ * them.
+ * @param gnl The reader.
+ * @param len The number of bytes to take.
+ * @return The null-terminated string, or NULL if memory allocation fails (the
+ * bytes are not consumed in that case).
+ */
+char	*gnl_take(t_gnl *gnl, size_t len)
+{
+	char	*line;
+
+	line = gnl_dup(gnl, len);
+	if (line)
+		gnl_store_consume(&gnl->store, len);
+	return (line);
+}
+
+/**
+ * @brief Clears the reader after EOF or an error, unless its last read was
+ * refused by the memory budget or found a non-blocking fd empty: the pending
+ * bytes are then kept, and the caller may try again once other fds have
+ * consumed theirs, or once the fd is readable. What the fd is (see gnl_burst)
+ * is looked up again on the next read: the fd may be closed and reused now.
+ * @param gnl The reader.
+ */
+void	gnl_clear(t_gnl *gnl)
+{
+	if (gnl->refused)
+		return ;
+	gnl_store_clear(&gnl->store);
+	gnl->stream = 0;
+}
+
+/**
+ * @brief Reads a line from a file descriptor.
+ * @param fd The file descriptor to read from.
+ * @return
+ * - A null-terminated string containing the line read, newline included.
+ *
+ * - NULL on error or EOF. errno is ENOBUFS if the memory budget refused to
+ *   read more for this fd until others consume (see gnl_set_budget), EMSGSIZE
+ *   if the line can never fit in the budget, EAGAIN if the fd is non-blocking
+ *   and the line is not complete yet: its pending bytes are kept.
+ * @note On EOF, read error or memory allocation failure the reader is cleared,
+ * whatever the storage, so nothing is left allocated. The line is consumed
+ * once copied: nothing of it stays buffered, and gnl_unread cannot push it
+ * back (peek with gnl_peek_line instead).
+ * @warning The returned string must be freed by the caller.
+ */
+char	*get_next_line(int fd)
+{
+	t_gnl		*gnl;
+	ssize_t		len;
+	char		*line;
+	uint64_t	t;
+
+	GNL_STAT_START(t);
+	line = NULL;
+	len = 0;
+	gnl = gnl_get(fd);
+	if (gnl && BUFFER_SIZE > 0)
+		len = gnl_line_len(gnl, fd);
+	if (len > 0)
+		line = gnl_take(gnl, len);
+	if (!line && gnl)
+		gnl_clear(gnl);
+	GNL_STAT_STOP(GNL_PHASE_CALL, t);
+	return (line);
+}
+
+/* ************************************************************************** */
+/* ************************* UNCOMMENT FOR TESTING  ************************* */
+/* ************************************************************************** */
+
+// Compile with -D GNL_MULTI_FD=1 to alternate between the three fds.
+// int	main(void)
+// {
+// 	int		fd1;
+// 	int		fd2;
+// 	int		fd3;
+// 	char	*line1;
+// 	char	*line2;
+// 	char	*line3;
+
+// 	fd1 = open("file0", O_RDONLY);
+// 	fd2 = open("file1", O_RDONLY);
+// 	fd3 = open("alphabet", O_RDONLY);
+// 	if (fd1 == -1 || fd2 == -1 || fd3 == -1)
+// 		return (printf("error"), 1);
+// 	while (1)
+// 	{
+// 		line1 = get_next_line(fd1);
+// 		line2 = get_next_line(fd2);
+// 		line3 = get_next_line(fd3);
+// 		(printf("%s", line1), printf("%s", line2), printf("%s", line3));
+// 		if (line3 == NULL)
+// 			break ;
+// 		(free(line1), free(line2), free(line3));
+// 	}
+// 	(close(fd1), close(fd2), close(fd3));
+// 	return (0);
+// }
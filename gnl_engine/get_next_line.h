@@ -0,0 +1,624 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line.h                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:02:11 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 16:27:45 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef GET_NEXT_LINE_H
+# define GET_NEXT_LINE_H
+
+/* ************************************************************************** */
+/*
+ * Build configuration, all chosen with -D flags:
+ * - BUFFER_SIZE: Minimum number of bytes requested from each read().
+ * - GNL_STORAGE: How the bytes read but not returned yet are kept.
+ *   - GNL_STORAGE_LIST: Linked list of chunks, as in gnl_list.
+ *   - GNL_STORAGE_BUF: One contiguous buffer, as in gnl_string and gnl_libft,
+ *     but compacted and grown in place instead of joined on every read.
+ *   - GNL_STORAGE_RING: Power of two ring buffer, grown only when full.
+ * - GNL_MULTI_FD: 0 keeps a single reader (mandatory part), 1 keeps one reader
+ *   per fd below MAX_FD (bonus part).
+ * - GNL_PEEK_SIZE: Bytes peeked at once from a pipe by gnl_copy_lines.
+ * - GNL_COUNT_BLOCK: Bytes read at once by gnl_count_lines.
+ * - GNL_DIRECT_ALIGN: Block size direct reads are aligned to (gnl_set_direct).
+ * - GNL_DIRECT_SIZE: Size and alignment of the direct read buffer mappings,
+ *   the size of a huge page.
+ * - GNL_READAHEAD: Bytes kept in readahead by GNL_CACHE_READAHEAD.
+ * - GNL_DROP_BLOCK: Consumed bytes dropped from the page cache at once by
+ *   GNL_CACHE_DROP.
+ * - GNL_PIPE_BLOCK: Bytes of input handed to each gnl_pipeline transform.
+ * - GNL_STATS: 1 records latency histograms of reads, scans, copies and whole
+ *   get_next_line calls (see gnl_stats_dump), 0 compiles them out.
+ * - GNL_STATS_TSC: 1 times with the CPU cycle counter (x86) instead of
+ *   clock_gettime: cheaper, but in cycles instead of nanoseconds.
+ * - GNL_BUDGET: 1 caps the bytes buffered across all readers: past the cap,
+ *   the fds holding the most are refused reads (see gnl_set_budget). The cap
+ *   counts pending bytes, not the memory holding them, which can be up to
+ *   about twice as much (see gnl_set_budget). 0 compiles the accounting out.
+ * - GNL_BUDGET_LIMIT: The cap GNL_BUDGET starts with, in bytes; 0 for none
+ *   until gnl_set_budget sets one.
+ * - GNL_READV: 1 sizes a read after one that filled its room to the bytes
+ *   the fd has ready (FIONREAD), so a burst on a pipe or socket is taken in by
+ *   one syscall. Only pipes and sockets are asked (one fstat per reader), not
+ *   files or sources. 0 always reads about BUFFER_SIZE bytes.
+ * - GNL_BURST_MAX: Most bytes read at once by GNL_READV.
+ * - GNL_CHECK_REUSE: 1 checks with fstat that the fd of a reader holding
+ *   bytes still refers to the same file, and drops the bytes if not (fd closed
+ *   and its number reused), when reuse is suspected: after a short read or
+ *   EOF, or after any fd was closed or reset. 0 relies on gnl_close/gnl_reset.
+ * Only the selected storage is compiled, so every call is a direct one.
+ */
+
+# ifndef BUFFER_SIZE
+#  define BUFFER_SIZE 42
+# endif
+
+# define GNL_STORAGE_LIST 1
+# define GNL_STORAGE_BUF 2
+# define GNL_STORAGE_RING 3
+
+# ifndef GNL_STORAGE
+#  define GNL_STORAGE GNL_STORAGE_BUF
+# endif
+
+# ifndef GNL_MULTI_FD
+#  define GNL_MULTI_FD 0
+# endif
+
+# ifndef MAX_FD
+#  define MAX_FD 1024
+# endif
+
+# ifndef GNL_PEEK_SIZE
+#  define GNL_PEEK_SIZE 65536
+# endif
+
+# ifndef GNL_COUNT_BLOCK
+#  define GNL_COUNT_BLOCK 1048576
+# endif
+
+# ifndef GNL_DIRECT_ALIGN
+#  define GNL_DIRECT_ALIGN 4096
+# endif
+
+# ifndef GNL_DIRECT_SIZE
+#  define GNL_DIRECT_SIZE 2097152
+# endif
+
+# ifndef GNL_READAHEAD
+#  define GNL_READAHEAD 4194304
+# endif
+
+# ifndef GNL_DROP_BLOCK
+#  define GNL_DROP_BLOCK 1048576
+# endif
+
+# define GNL_CACHE_SEQUENTIAL 1
+# define GNL_CACHE_READAHEAD 2
+# define GNL_CACHE_DROP 4
+
+# ifndef GNL_PIPE_BLOCK
+#  define GNL_PIPE_BLOCK 1048576
+# endif
+
+# ifndef GNL_STATS
+#  define GNL_STATS 0
+# endif
+
+# ifndef GNL_STATS_TSC
+#  define GNL_STATS_TSC 0
+# endif
+
+# ifndef GNL_BUDGET
+#  define GNL_BUDGET 0
+# endif
+
+# ifndef GNL_BUDGET_LIMIT
+#  define GNL_BUDGET_LIMIT 0
+# endif
+
+# ifndef GNL_READV
+#  define GNL_READV 0
+# endif
+
+# ifndef GNL_BURST_MAX
+#  define GNL_BURST_MAX 1048576
+# endif
+
+# ifndef GNL_CHECK_REUSE
+#  define GNL_CHECK_REUSE 0
+# endif
+
+# define GNL_PHASE_READ 0
+# define GNL_PHASE_SCAN 1
+# define GNL_PHASE_COPY 2
+# define GNL_PHASE_CALL 3
+# define GNL_PHASES 4
+
+# define GNL_UTF8_REPORT 0
+# define GNL_UTF8_REPLACE 1
+# define GNL_UTF8_REJECT 2
+
+# define GNL_HUGE_NONE 0
+# define GNL_HUGE_THP 1
+# define GNL_HUGE_TLB 2
+
+/* ************************************************************************** */
+
+# include <fcntl.h>  // For file control options and constants like O_RDONLY
+# include <stdio.h>  // For printf
+# include <stdlib.h> // For dynamic memory allocation (malloc, free) and size_t.
+# include <unistd.h> // For system calls like write, open, read, close.
+# include <sys/types.h> // For ssize_t.
+# include <stdint.h> // For uint64_t.
+# include <sys/uio.h> // For struct iovec and readv.
+
+/*
+ * Latency recording points: free when GNL_STATS is 0.
+ */
+# if GNL_STATS
+#  define GNL_STAT_START(t) ((t) = gnl_stats_now())
+#  define GNL_STAT_STOP(phase, t) gnl_stats_record((phase), (t))
+# else
+#  define GNL_STAT_START(t) ((t) = 0)
+#  define GNL_STAT_STOP(phase, t) ((void)(t))
+# endif
+
+/*
+ * Memory budget accounting points: free when GNL_BUDGET is 0.
+ */
+# if GNL_BUDGET
+#  define GNL_BUDGET_MOVE(before, after) gnl_budget_move((before), (after))
+#  define GNL_BUDGET_REFUSES(len, room) gnl_budget_refuses((len), (room))
+# else
+#  define GNL_BUDGET_MOVE(before, after) ((void)0)
+#  define GNL_BUDGET_REFUSES(len, room) 0
+# endif
+
+/*
+ * Fd reuse checking points: free when GNL_CHECK_REUSE is 0.
+ */
+# if GNL_CHECK_REUSE
+#  define GNL_NOTE_FD(gnl, fd) gnl_note_fd((gnl), (fd))
+#  define GNL_CHECK_FD(gnl, fd) gnl_check_fd((gnl), (fd))
+# else
+#  define GNL_NOTE_FD(gnl, fd) ((void)0)
+#  define GNL_CHECK_FD(gnl, fd) ((void)0)
+# endif
+
+/* ************************************************************************** */
+
+/*
+ * Allocator of a reader's buffers (see gnl_set_alloc): free is given back the
+ * size the block was allocated with. NULL functions mean malloc and free.
+ */
+typedef struct s_gnl_alloc
+{
+	void	*(*alloc)(void *ctx, size_t size);
+	void	(*free)(void *ctx, void *ptr, size_t size);
+	void	*ctx;
+}	t_gnl_alloc;
+
+# if GNL_STORAGE == GNL_STORAGE_LIST
+
+typedef struct s_chunk
+{
+	size_t			len;
+	size_t			cap;
+	struct s_chunk	*next;
+	char			data[];
+}	t_chunk;
+
+typedef struct s_store
+{
+	t_chunk		*head;
+	t_chunk		*tail;
+	size_t		off;
+	size_t		len;
+	t_chunk		*spare;
+	t_gnl_alloc	alloc;
+}	t_store;
+
+# elif GNL_STORAGE == GNL_STORAGE_BUF
+
+typedef struct s_store
+{
+	char		*data;
+	size_t		start;
+	size_t		end;
+	size_t		cap;
+	size_t		align;
+	int			huge;
+	int			borrowed;
+	t_gnl_alloc	alloc;
+}	t_store;
+
+# elif GNL_STORAGE == GNL_STORAGE_RING
+
+typedef struct s_store
+{
+	char		*data;
+	size_t		head;
+	size_t		len;
+	size_t		cap;
+	t_gnl_alloc	alloc;
+}	t_store;
+
+# else
+#  error "GNL_STORAGE must be GNL_STORAGE_LIST, GNL_STORAGE_BUF or _RING"
+# endif
+
+/*
+ * Page cache policies of a reader, see gnl_set_cache. Offsets in the file:
+ * - pos: End of the bytes read so far.
+ * - ahead: End of the range already requested with readahead.
+ * - dropped: End of the range already dropped from the page cache.
+ */
+typedef struct s_cache
+{
+	int		policy;
+	off_t	pos;
+	off_t	ahead;
+	off_t	dropped;
+}	t_cache;
+
+/*
+ * The inotify watches of a reader followed with gnl_follow, kept from one call
+ * to the next until gnl_close or gnl_reset.
+ * - on: The watches are set.
+ * - ino: The inotify instance.
+ * - file, dir: Watch descriptors of the file and of its directory.
+ */
+typedef struct s_watch
+{
+	int	on;
+	int	ino;
+	int	file;
+	int	dir;
+}	t_watch;
+
+/*
+ * A source of bytes other than a fd, see gnl_open_source.
+ * - read: Reads up to len bytes into buf. Returns the number of bytes read, 0
+ *   at the end, -1 on error (with errno set). NULL: nothing more to read.
+ * - close: Releases ctx, called by gnl_close (NULL: nothing to release).
+ */
+typedef struct s_gnl_source
+{
+	ssize_t	(*read)(void *ctx, char *buf, size_t len);
+	void	(*close)(void *ctx);
+}	t_gnl_source;
+
+/*
+ * A reader: the bytes read from a fd and not returned yet.
+ * - held: Bytes at the start of the store handed out by the last call as a
+ *   view (gnl_next_view, gnl_peek_line, a record of gnl_next_record), which
+ *   must stay valid. They are consumed by gnl_get on the next call, unless
+ *   gnl_unread pushes them back first.
+ * - cache: Page cache policies, applied by gnl_fill.
+ * - watch: inotify watches of gnl_follow.
+ * - refused: The last read was refused by the memory budget (the errno it
+ *   gave), or found nothing ready on a non-blocking fd: the pending bytes are
+ *   kept (see gnl_clear).
+ * - dev, ino: The file the pending bytes were read from, if known
+ *   (GNL_CHECK_REUSE).
+ * - gen: The reuse generation when the file was last checked.
+ * - suspect: The last read was short or hit EOF: the file is checked again.
+ * - burst: The last read filled all its room: more may be ready (GNL_READV).
+ * - stream: The fd is a pipe or socket (1), something else (-1), or was not
+ *   looked at yet (0): only a stream is asked how much is ready (GNL_READV).
+ * - source, ctx: Where the reader reads from instead of the fd, if not NULL.
+ */
+typedef struct s_gnl
+{
+	t_store				store;
+	size_t				held;
+	t_cache				cache;
+	t_watch				watch;
+	int					refused;
+	dev_t				dev;
+	ino_t				ino;
+	int					known;
+	unsigned int		gen;
+	int					suspect;
+	int					burst;
+	int					stream;
+	const t_gnl_source	*source;
+	void				*ctx;
+}	t_gnl;
+
+typedef int	(*t_gnl_line_fn)(const char *line, size_t len, void *userdata);
+
+typedef struct s_gnl_filter
+{
+	t_gnl_line_fn	keep;
+	void			*userdata;
+}	t_gnl_filter;
+
+/*
+ * A CSV/TSV record, see gnl_next_record. Field spans are offsets into data.
+ */
+typedef struct s_gnl_field
+{
+	size_t	off;
+	size_t	len;
+	int		quoted;
+}	t_gnl_field;
+
+typedef struct s_gnl_record
+{
+	const char	*data;
+	size_t		len;
+	t_gnl_field	*fields;
+	size_t		count;
+	size_t		cap;
+}	t_gnl_record;
+
+/*
+ * A reader over several files, read as one stream, see gnl_cat_open.
+ * - paths: The files, in order (owned by the reader).
+ * - index: The file being read.
+ * - fd: Its fd, or -1 before the first line.
+ * - next: The next file, already opened and prefetched, or -1.
+ */
+typedef struct s_gnl_cat
+{
+	char	**paths;
+	size_t	count;
+	size_t	index;
+	int		fd;
+	int		next;
+}	t_gnl_cat;
+
+/*
+ * The lines already seen by gnl_next_unique: an open addressing set of line
+ * hashes (0 marks an empty slot). Zero it before the first call; set exact to
+ * also keep the lines themselves in an arena, so that a hash collision is
+ * never taken for a duplicate.
+ * - spans: With exact, the offset and length in arena of each slot's line.
+ */
+typedef struct s_gnl_dedup
+{
+	uint64_t	*hashes;
+	size_t		*spans;
+	char		*arena;
+	size_t		arena_len;
+	size_t		arena_cap;
+	size_t		cap;
+	size_t		count;
+	int			exact;
+}	t_gnl_dedup;
+
+/*
+ * What gnl_next_utf8 found. Zero it before the first call.
+ * - valid: Whether the line read was valid UTF-8.
+ * - error: If not, the offset of its first invalid byte.
+ * - rejected: Invalid lines skipped so far (GNL_UTF8_REJECT).
+ */
+typedef struct s_gnl_utf8
+{
+	int		valid;
+	size_t	error;
+	size_t	rejected;
+}	t_gnl_utf8;
+
+/*
+ * A parallel pipeline, see gnl_pipeline.
+ * - transform: Called by the workers on each block of whole lines. Sets *out
+ *   to a malloc'ed result (or NULL) and returns its length, -1 on error.
+ * - emit: Called by the calling thread with each result, in input order.
+ *   Returns 0 to go on, anything else to stop.
+ * - workers: Number of worker threads (0: one per online CPU).
+ * - window: Most blocks read but not emitted yet (0: twice the workers).
+ */
+typedef struct s_gnl_pipe
+{
+	ssize_t	(*transform)(const char *block, size_t len, char **out,
+			void *userdata);
+	int		(*emit)(const char *out, size_t len, void *userdata);
+	void	*userdata;
+	size_t	workers;
+	size_t	window;
+}	t_gnl_pipe;
+
+/* ************************************************************************** */
+/*
+ * Get Next Line Functions:
+ * - get_next_line: Reads a line from the file descriptor.
+ * - gnl_for_each_line: Calls a function for each line, straight from the read
+ *   buffer. Lines are not allocated, only copied when they straddle two reads.
+ * - gnl_copy_lines: Forwards lines from one fd to another inside the kernel.
+ * - gnl_copy_lines_if: Same, keeping only the lines a filter accepts.
+ * - gnl_count_lines: Counts the lines left in a fd, without allocating them.
+ * - gnl_count_lines_range: Counts the lines in a byte range of a file.
+ * - gnl_next_matching: Returns the next line containing a string.
+ * - gnl_next_prefixed: Returns the next line starting with a string.
+ * - gnl_next_record: Splits the next CSV/TSV record into fields, in place.
+ * - gnl_record_free: Frees the field array of a record.
+ * - gnl_set_direct: Switches a fd to O_DIRECT reads into aligned buffers.
+ * - gnl_set_cache: Sets the page cache policies of a fd (sequential hint,
+ *   readahead, drop-behind).
+ * - gnl_follow: Returns the next line of a growing file, waiting for it with
+ *   inotify and following truncation and rotation (tail -F).
+ * - gnl_cat_open, gnl_cat_glob: Create a reader over several files, given as
+ *   a list of paths or a glob pattern (GNL_MULTI_FD builds only).
+ * - gnl_cat_next_line: Returns the next line of the files, read in order;
+ *   NULL with errno 0 at the end, with errno set for a file that failed.
+ * - gnl_cat_close: Closes the files and frees the reader.
+ * - gnl_next_unique: Returns the next line not returned before.
+ * - gnl_dedup_free: Frees the set of lines seen.
+ * - gnl_next_utf8: Returns the next line, checked as UTF-8 while its newline is
+ *   looked for, reporting, replacing or rejecting invalid sequences.
+ * - gnl_pipeline: Transforms the lines of a stream on several threads,
+ *   emitting the results in input order.
+ * - gnl_stats_dump: Writes the latency histograms (GNL_STATS builds).
+ * - gnl_stats_value_at: Returns a percentile of a latency histogram.
+ * - gnl_stats_reset: Empties the latency histograms.
+ * - gnl_set_budget: Caps the bytes buffered across all readers (GNL_BUDGET
+ *   builds).
+ * - gnl_budget_used: Returns the bytes buffered across all readers.
+ * - gnl_reset: Drops the state of a fd, before its number is reused.
+ * - gnl_close: Closes a fd and drops its state.
+ * - gnl_open_source: Returns a descriptor reading from a callback (GNL_MULTI_FD
+ *   builds only).
+ * - gnl_open_memory: Returns a descriptor reading from memory, whose lines are
+ *   views into it (GNL_STORAGE_BUF).
+ * - gnl_next_view: Returns the next line as a view into the read buffer.
+ * - gnl_set_alloc: Makes the buffers of a fd come from a custom allocator.
+ * - gnl_peek_line: Returns the next line as a view, without consuming it.
+ * - gnl_unread: Pushes back the end of the line the last call returned.
+ *
+ * Engine Functions (shared by every entry point):
+ * - gnl_slot: Returns the reader of a fd (the single one, or the fd's slot).
+ * - gnl_get: Same, consuming the line the previous call handed out, if any.
+ * - gnl_fill: Reads once from the fd into the free tail of the store.
+ * - gnl_line_len: Reads until the next line is complete, returns its length.
+ * - gnl_take: Returns the first bytes of the store as a new string.
+ * - gnl_clear: Clears the reader after EOF or an error, unless the memory
+ *   budget refused the last read or the fd had nothing ready.
+ * - gnl_map, gnl_unmap: Maps or unmaps a 2 MiB aligned direct read buffer.
+ * - gnl_direct_off: Drops O_DIRECT from a fd after a refused read.
+ * - gnl_cache_step: Applies the page cache policies after a read.
+ * - gnl_read_ahead: Asks the kernel to read part of a file in advance.
+ * - gnl_stats_now, gnl_stats_record: Time a phase into its histogram.
+ * - gnl_budget_move: Records a change in the pending bytes of a store.
+ * - gnl_budget_refuses: Tells whether the memory budget refuses a read.
+ * - gnl_note_fd, gnl_check_fd: Record and check the file a reader reads from.
+ * - gnl_alloc, gnl_free: Allocate and free a store block with its allocator.
+ *
+ * Storage Functions (one implementation compiled, see GNL_STORAGE):
+ * - gnl_store_len: Number of bytes read but not consumed.
+ * - gnl_store_find: Index of a byte in the pending bytes, from an offset.
+ * - gnl_store_reserve: Returns free space at the tail to read into.
+ * - gnl_store_reserve_iov: Same, in one or two parts, for readv.
+ * - gnl_store_commit: Marks bytes written to the reserved space as pending.
+ * - gnl_store_copy: Copies the first pending bytes out.
+ * - gnl_store_data: Makes the pending bytes contiguous and points to them.
+ * - gnl_store_consume: Drops the first pending bytes.
+ * - gnl_store_clear: Frees everything.
+ * - gnl_store_align: Moves the buffer to aligned mappings (GNL_STORAGE_BUF).
+ * - gnl_store_borrow: Points the store into the caller's memory, if the
+ *   storage can (GNL_STORAGE_BUF).
+ *
+ * Memory Utility Functions:
+ * - ft_memmove: Copies memory areas that may overlap, 8 bytes at a time.
+ * - ft_memrchr: Scans memory backwards for a byte.
+ * - ft_memcmp: Compares two memory areas.
+ *
+ * Scanning Kernels (SSE2, or 8 bytes at a time):
+ * - ft_memchr: Scans memory for a byte.
+ * - ft_memcpy: Copies memory from source to destination.
+ * - ft_strlen: Returns the length of a string.
+ * - ft_memcount: Counts the occurrences of a byte in memory.
+ * - ft_memmem: Locates a byte string in memory.
+ * - ft_memchr3: Scans memory for the first of 3 bytes.
+ * - ft_memchr_hash: Scans memory for a newline, hashing the bytes before it.
+ * - ft_utf8_len: Checks the UTF-8 sequence at the start of memory.
+ * - ft_memchr_utf8: Scans memory for a newline, checking the bytes before it
+ *   are UTF-8.
+ */
+/* ************************************************************************** */
+
+char	*get_next_line(int fd);
+int		gnl_for_each_line(int fd, t_gnl_line_fn callback, void *userdata);
+ssize_t	gnl_copy_lines(int fd_in, int fd_out, size_t n_lines);
+ssize_t	gnl_copy_lines_if(int fd_in, int fd_out, size_t n_lines,
+			t_gnl_filter filter);
+ssize_t	gnl_count_lines(int fd);
+ssize_t	gnl_count_lines_range(int fd, off_t off, size_t len);
+char	*gnl_next_matching(int fd, const char *needle);
+char	*gnl_next_prefixed(int fd, const char *prefix);
+int		gnl_next_record(int fd, char delim, t_gnl_record *rec);
+void	gnl_record_free(t_gnl_record *rec);
+int		gnl_set_direct(int fd, int huge);
+int		gnl_set_cache(int fd, int policy);
+char	*gnl_follow(int fd, const char *path, int timeout);
+t_gnl_cat	*gnl_cat_open(char *const *paths, size_t count);
+t_gnl_cat	*gnl_cat_glob(const char *pattern);
+char	*gnl_cat_next_line(t_gnl_cat *cat);
+void	gnl_cat_close(t_gnl_cat *cat);
+char	*gnl_next_unique(int fd, t_gnl_dedup *set);
+void	gnl_dedup_free(t_gnl_dedup *set);
+char	*gnl_next_utf8(int fd, int mode, t_gnl_utf8 *info);
+int		gnl_pipeline(int fd, const t_gnl_pipe *cfg);
+# if GNL_STATS
+int		gnl_stats_dump(int fd);
+uint64_t	gnl_stats_value_at(int phase, double percentile);
+void	gnl_stats_reset(void);
+# endif
+# if GNL_BUDGET
+void	gnl_set_budget(size_t limit);
+size_t	gnl_budget_used(void);
+# endif
+void	gnl_reset(int fd);
+int		gnl_close(int fd);
+int		gnl_open_source(const t_gnl_source *source, void *ctx);
+int		gnl_open_memory(const char *data, size_t len);
+const char	*gnl_next_view(int fd, size_t *len);
+int		gnl_set_alloc(int fd, const t_gnl_alloc *alloc);
+const char	*gnl_peek_line(int fd, size_t *len);
+int		gnl_unread(int fd, size_t n);
+
+t_gnl	*gnl_slot(int fd);
+t_gnl	*gnl_get(int fd);
+ssize_t	gnl_fill(t_gnl *gnl, int fd);
+ssize_t	gnl_line_len(t_gnl *gnl, int fd);
+char	*gnl_take(t_gnl *gnl, size_t len);
+void	gnl_clear(t_gnl *gnl);
+char	*gnl_map(size_t size, int huge);
+void	gnl_unmap(char *map, size_t size);
+int		gnl_direct_off(int fd);
+void	gnl_cache_step(t_gnl *gnl, int fd, ssize_t bytes_read);
+void	gnl_read_ahead(int fd, off_t off, size_t len);
+# if GNL_STATS
+uint64_t	gnl_stats_now(void);
+void	gnl_stats_record(int phase, uint64_t start);
+# endif
+# if GNL_BUDGET
+void	gnl_budget_move(size_t before, size_t after);
+int		gnl_budget_refuses(size_t len, size_t room);
+# endif
+void	*gnl_alloc(const t_gnl_alloc *alloc, size_t size);
+void	gnl_free(const t_gnl_alloc *alloc, void *ptr, size_t size);
+# if GNL_CHECK_REUSE
+void	gnl_note_fd(t_gnl *gnl, int fd);
+void	gnl_check_fd(t_gnl *gnl, int fd);
+# endif
+
+size_t	gnl_store_len(const t_store *st);
+ssize_t	gnl_store_find(const t_store *st, size_t from, int c);
+char	*gnl_store_reserve(t_store *st, size_t *room);
+int		gnl_store_reserve_iov(t_store *st, struct iovec *iov, size_t room);
+void	gnl_store_commit(t_store *st, size_t n);
+void	gnl_store_copy(const t_store *st, char *dst, size_t n);
+char	*gnl_store_data(t_store *st);
+void	gnl_store_consume(t_store *st, size_t n);
+void	gnl_store_clear(t_store *st);
+int		gnl_store_borrow(t_store *st, const char *data, size_t len);
+# if GNL_STORAGE == GNL_STORAGE_BUF
+int		gnl_store_align(t_store *st, size_t align, int huge);
+# endif
+
+void	*ft_memmove(void *dest, const void *src, size_t n);
+void	*ft_memrchr(const void *s, int c, size_t n);
+int		ft_memcmp(const void *s1, const void *s2, size_t n);
+
+void	*ft_memchr(const void *s, int c, size_t n);
+void	*ft_memcpy(void *dest, const void *src, size_t n);
+size_t	ft_strlen(const char *s);
+size_t	ft_memcount(const void *s, int c, size_t n);
+void	*ft_memmem(const void *hay, size_t hlen, const void *needle,
+			size_t nlen);
+const char	*ft_memchr3(const char *s, size_t n, const char set[3]);
+ssize_t	ft_memchr_hash(const char *s, size_t n, uint64_t *h);
+ssize_t	ft_utf8_len(const char *s, size_t n);
+ssize_t	ft_memchr_utf8(const char *s, size_t n, size_t *checked, int *bad);
+
+/* ************************************************************************** */
+#endif
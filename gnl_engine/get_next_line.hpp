@@ -0,0 +1,400 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 03:21:40 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 17:08:56 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef GET_NEXT_LINE_HPP
+# define GET_NEXT_LINE_HPP
+
+# include <cerrno>
+# include <cstddef>
+# include <iterator>
+# include <memory_resource>
+# include <optional>
+# include <string>
+# include <string_view>
+# include <utility>
+
+extern "C"
+{
+# include "get_next_line.h"
+}
+
+/* ************************************************************************** */
+/*
+ * Header-only C++17 wrapper around gnl_next_view(). The engine itself is still
+ * compiled as C and linked in; this only adds ownership and range iteration:
+ *
+ *	for (std::string_view line : gnl::LineReader(fd))
+ *		...
+ *
+ * Each line is a view into the reader's buffer (newline included, like
+ * get_next_line), so nothing is allocated per line. A view is only valid until
+ * the iterator is advanced: copy it into a std::string to keep it.
+ *
+ * A reader may also be given a std::pmr::memory_resource: its buffers are then
+ * allocated from it (see gnl_set_alloc), and so are the strings of
+ * next_string(), e.g. a monotonic buffer for a reader living as long as one
+ * request, or a pool per worker thread instead of the global malloc.
+ */
+/* ************************************************************************** */
+
+namespace gnl
+{
+
+namespace detail
+{
+
+inline void	*pmr_alloc(void *ctx, size_t size) noexcept
+{
+	try
+	{
+		return (static_cast<std::pmr::memory_resource *>(ctx)->allocate(size,
+				alignof(std::max_align_t)));
+	}
+	catch (...)
+	{
+		return (nullptr);
+	}
+}
+
+inline void	pmr_free(void *ctx, void *ptr, size_t size) noexcept
+{
+	static_cast<std::pmr::memory_resource *>(ctx)->deallocate(ptr, size,
+		alignof(std::max_align_t));
+}
+
+}
+
+/**
+ * @brief Owns the reader state of one fd (or source) and iterates its lines.
+ * @note Movable, not copyable: two objects would share the same fd state.
+ */
+class LineReader
+{
+public:
+	class iterator;
+
+	/**
+	 * @brief Wraps fd; on destruction, gnl_close() it if own is true (the
+	 * default), else only gnl_reset() it and leave it open.
+	 */
+	explicit LineReader(int fd, bool own = true) noexcept
+		: fd_(fd), own_(own), error_(0), resource_(nullptr)
+	{
+	}
+
+	/**
+	 * @brief Same, with the buffers of fd allocated from resource, which must
+	 * outlive the reader.
+	 * @note If fd already holds pending bytes (or is invalid), error() is set
+	 * and the buffers stay with their previous allocator.
+	 */
+	LineReader(int fd, std::pmr::memory_resource *resource, bool own = true)
+		noexcept : LineReader(fd, own)
+	{
+		const t_gnl_alloc	alloc = {detail::pmr_alloc, detail::pmr_free,
+			resource};
+
+		resource_ = resource;
+		if (resource && gnl_set_alloc(fd, &alloc) == -1)
+			error_ = errno;
+	}
+
+	/**
+	 * @brief Reads the lines of data without copying it (see gnl_open_memory).
+	 * @note data must outlive the reader. valid() is false if opening failed,
+	 * as it always does in single-reader builds (GNL_MULTI_FD 0), and error()
+	 * is then why. Otherwise error() is set if resource could not be given to
+	 * the reader, as with the constructor; with GNL_STORAGE_BUF nothing is
+	 * allocated at all, so resource is only used by next_string().
+	 */
+	static LineReader	from_memory(std::string_view data,
+		std::pmr::memory_resource *resource = nullptr) noexcept
+	{
+		const int	fd = gnl_open_memory(data.data(), data.size());
+		const int	error = errno;
+		LineReader	reader(fd, resource);
+
+		if (fd < 0)
+			reader.error_ = error;
+		else if (GNL_STORAGE == GNL_STORAGE_BUF && reader.error_ == EBUSY)
+			reader.error_ = 0;
+		return (reader);
+	}
+
+	LineReader(const LineReader &) = delete;
+	LineReader	&operator=(const LineReader &) = delete;
+
+	LineReader(LineReader &&other) noexcept
+		: fd_(std::exchange(other.fd_, -1)), own_(other.own_),
+		error_(other.error_), resource_(other.resource_)
+	{
+	}
+
+	LineReader	&operator=(LineReader &&other) noexcept
+	{
+		if (this != &other)
+		{
+			release_fd();
+			fd_ = std::exchange(other.fd_, -1);
+			own_ = other.own_;
+			error_ = other.error_;
+			resource_ = other.resource_;
+		}
+		return (*this);
+	}
+
+	~LineReader()
+	{
+		release_fd();
+	}
+
+	/**
+	 * @brief Reads the next line into line.
+	 * @return true if a line was read; false at EOF or on error (see error()).
+	 */
+	bool	next(std::string_view &line) noexcept
+	{
+		const char	*data;
+		size_t		len;
+
+		if (fd_ < 0)
+			return (false);
+		errno = 0;
+		data = gnl_next_view(fd_, &len);
+		if (!data)
+		{
+			error_ = errno;
+			return (false);
+		}
+		line = std::string_view(data, len);
+		return (true);
+	}
+
+	/**
+	 * @brief Looks at the next line without consuming it: next() returns it
+	 * again. See gnl_peek_line().
+	 * @return true if there is a line; false at EOF or on error.
+	 */
+	bool	peek(std::string_view &line) noexcept
+	{
+		const char	*data;
+		size_t		len;
+
+		if (fd_ < 0)
+			return (false);
+		errno = 0;
+		data = gnl_peek_line(fd_, &len);
+		if (!data)
+		{
+			error_ = errno;
+			return (false);
+		}
+		line = std::string_view(data, len);
+		return (true);
+	}
+
+	/**
+	 * @brief Pushes back the last n bytes of the line next() just returned.
+	 * See gnl_unread().
+	 * @return false if n is larger than that line, or nothing was returned.
+	 * @note Works after both next() overloads, which read views.
+	 */
+	bool	unread(size_t n) noexcept
+	{
+		return (fd_ >= 0 && gnl_unread(fd_, n) == 0);
+	}
+
+	/**
+	 * @brief Reads the next line into line, copied with line's allocator.
+	 * @return true if a line was read; false at EOF or on error.
+	 */
+	bool	next(std::pmr::string &line)
+	{
+		std::string_view	view;
+
+		if (!next(view))
+			return (false);
+		line.assign(view);
+		return (true);
+	}
+
+	/**
+	 * @brief Returns a copy of the next line allocated from the reader's
+	 * resource (the default resource if it has none), or std::nullopt at EOF
+	 * or on error.
+	 */
+	std::optional<std::pmr::string>	next_string()
+	{
+		std::string_view	view;
+
+		if (!next(view))
+			return (std::nullopt);
+		if (!resource_)
+			return (std::pmr::string(view));
+		return (std::pmr::string(view, resource_));
+	}
+
+	iterator	begin() noexcept;
+	iterator	end() noexcept;
+
+	bool	valid() const noexcept
+	{
+		return (fd_ >= 0);
+	}
+
+	int	fd() const noexcept
+	{
+		return (fd_);
+	}
+
+	/** @brief The resource of the reader's buffers, nullptr for malloc. */
+	std::pmr::memory_resource	*resource() const noexcept
+	{
+		return (resource_);
+	}
+
+	/** @brief errno of the failure that ended the lines, 0 for a clean EOF. */
+	int	error() const noexcept
+	{
+		return (error_);
+	}
+
+	/**
+	 * @brief Gives up ownership: the state and the fd are left as they are.
+	 * @return The fd, which the caller must now gnl_close().
+	 */
+	int	release() noexcept
+	{
+		return (std::exchange(fd_, -1));
+	}
+
+private:
+	void	release_fd() noexcept
+	{
+		if (fd_ < 0)
+			return ;
+		if (own_)
+			gnl_close(fd_);
+		else
+			gnl_reset(fd_);
+		fd_ = -1;
+	}
+
+	int							fd_;
+	bool						own_;
+	int							error_;
+	std::pmr::memory_resource	*resource_;
+};
+
+/**
+ * @brief Single-pass input iterator over the lines of a LineReader; the end
+ * iterator is the one with no reader.
+ */
+class LineReader::iterator
+{
+public:
+	using iterator_category = std::input_iterator_tag;
+	using value_type = std::string_view;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const std::string_view *;
+	using reference = const std::string_view &;
+
+	iterator() noexcept : reader_(nullptr)
+	{
+	}
+
+	explicit iterator(LineReader *reader) noexcept : reader_(reader)
+	{
+		++*this;
+	}
+
+	reference	operator*() const noexcept
+	{
+		return (line_);
+	}
+
+	pointer	operator->() const noexcept
+	{
+		return (&line_);
+	}
+
+	iterator	&operator++() noexcept
+	{
+		if (reader_ && !reader_->next(line_))
+			reader_ = nullptr;
+		return (*this);
+	}
+
+	void	operator++(int) noexcept
+	{
+		++*this;
+	}
+
+	friend bool	operator==(const iterator &a, const iterator &b) noexcept
+	{
+		return (a.reader_ == b.reader_);
+	}
+
+	friend bool	operator!=(const iterator &a, const iterator &b) noexcept
+	{
+		return (a.reader_ != b.reader_);
+	}
+
+private:
+	LineReader			*reader_;
+	std::string_view	line_;
+};
+
+inline LineReader::iterator	LineReader::begin() noexcept
+{
+	return (iterator(this));
+}
+
+inline LineReader::iterator	LineReader::end() noexcept
+{
+	return (iterator());
+}
+
+}
+
+#endif
+
+/* ************************************************************************** */
+/* UNCOMMENT FOR TESTING, build the engine as C and link it:
+ * cc -D GNL_MULTI_FD=1 -c get_next_line*.c
+ * c++ -std=c++17 -D GNL_MULTI_FD=1 main.cpp get_next_line*.o
+ */
+/* ************************************************************************** */
+
+/*
+#include <fcntl.h>
+#include <iostream>
+#include "get_next_line.hpp"
+
+int	main(int argc, char **argv)
+{
+	size_t	count;
+
+	count = 0;
+	if (argc < 2)
+		return (1);
+	for (std::string_view line : gnl::LineReader(open(argv[1], O_RDONLY)))
+	{
+		std::cout << line;
+		count++;
+	}
+	for (std::string_view line : gnl::LineReader::from_memory("a\nb\nc"))
+		std::cout << "[" << line << "]";
+	std::cout << "\n" << count << " lines" << std::endl;
+	return (0);
+}
+*/
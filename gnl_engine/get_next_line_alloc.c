@@ -0,0 +1,73 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_alloc.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 05:02:26 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/20 05:02:26 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+#include <errno.h>
+
+/*
+ * Custom allocators. Every buffer of a store (the buffer, the ring, the
+ * chunks) comes from the allocator kept in the store, malloc by default, so a
+ * reader can live in an arena, a per-thread pool or a per-request region (see
+ * gnl::LineReader in get_next_line.hpp, which takes a std::pmr resource).
+ * Blocks are freed with the size they were allocated with, which malloc does
+ * not need but memory resources do. Not covered: the aligned mappings of
+ * direct reads (see gnl_set_direct) and the lines returned by get_next_line,
+ * which stay malloc'd since the caller frees them with free.
+ */
+
+/**
+ * @brief Allocates a store block of `size` bytes with alloc, or malloc.
+ */
+void	*gnl_alloc(const t_gnl_alloc *alloc, size_t size)
+{
+	if (alloc->alloc)
+		return (alloc->alloc(alloc->ctx, size));
+	return (malloc(size));
+}
+
+/**
+ * @brief Frees a store block of `size` bytes allocated by gnl_alloc.
+ */
+void	gnl_free(const t_gnl_alloc *alloc, void *ptr, size_t size)
+{
+	if (!ptr)
+		return ;
+	if (alloc->free)
+		alloc->free(alloc->ctx, ptr, size);
+	else
+		free(ptr);
+}
+
+/**
+ * @brief Makes the buffers of a fd come from alloc from now on.
+ * @param fd The file descriptor (or source, see gnl_open_source).
+ * @param alloc The allocator, copied; NULL for malloc and free again.
+ * @return 0 on success, -1 if fd is invalid or if the reader holds pending
+ * bytes (errno is EBUSY): they were allocated by the previous allocator.
+ * @note The allocator stays with the fd until gnl_close or gnl_reset; EOF and
+ * errors free the buffers but keep it.
+ */
+int	gnl_set_alloc(int fd, const t_gnl_alloc *alloc)
+{
+	t_gnl	*gnl;
+
+	gnl = gnl_get(fd);
+	if (!gnl)
+		return (-1);
+	if (gnl_store_len(&gnl->store))
+		return (errno = EBUSY, -1);
+	gnl_store_clear(&gnl->store);
+	gnl->store.alloc = (t_gnl_alloc){0};
+	if (alloc)
+		gnl->store.alloc = *alloc;
+	return (0);
+}
@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_budget.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 00:12:05 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 16:27:45 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+#include <errno.h>
+
+#if GNL_BUDGET
+
+/*
+ * Process-wide memory budget. Every store reports the changes of its pending
+ * bytes, so the total buffered across all readers is known without walking
+ * the reader table. While a read fits in the cap, anybody reads. Past it, only
+ * readers holding less than their share of the cap (the cap divided by the
+ * readers holding bytes) may still read: the few fds receiving enormous lines
+ * are stopped, while the many with a short line pending can still complete
+ * it. The total can thus pass the cap only through readers below their share.
+ * A reader stopped so may read on once the others have consumed, so a reader
+ * holding bytes alone is never stopped. Only one that holds the whole cap
+ * without a complete line is, for good: its line can never fit.
+ * Only pending bytes are counted, not the capacity around them: what a store
+ * allocates past its pending bytes depends on the storage and would make the
+ * shares depend on it too.
+ */
+
+/**
+ * @brief The budget.
+ * - limit: The cap in bytes, 0 for none.
+ * - used: Pending bytes across all readers.
+ * - readers: Readers holding pending bytes.
+ */
+typedef struct s_budget
+{
+	size_t	limit;
+	size_t	used;
+	size_t	readers;
+}	t_budget;
+
+/**
+ * @brief Returns the budget of the process.
+ */
+static t_budget	*gnl_budget(void)
+{
+	static t_budget	budget = {GNL_BUDGET_LIMIT, 0, 0};
+
+	return (&budget);
+}
+
+/**
+ * @brief Records a change in the pending bytes of a store.
+ * @param before The pending bytes before the change.
+ * @param after The pending bytes after the change.
+ */
+void	gnl_budget_move(size_t before, size_t after)
+{
+	t_budget	*budget;
+
+	budget = gnl_budget();
+	budget->used += after - before;
+	budget->readers += (!before && after);
+	budget->readers -= (before && !after);
+}
+
+/**
+ * @brief Tells whether a reader may read more.
+ * @param len The pending bytes of the reader.
+ * @param room The bytes it is about to read.
+ * @return 0 if it may. If the read would pass the cap: EMSGSIZE if the reader
+ * holds the whole cap already (its line can never fit), ENOBUFS if it holds
+ * its share of it (it may read once the others have consumed).
+ */
+int	gnl_budget_refuses(size_t len, size_t room)
+{
+	t_budget	*budget;
+
+	budget = gnl_budget();
+	if (!budget->limit || budget->used + room <= budget->limit)
+		return (0);
+	if (len >= budget->limit)
+		return (EMSGSIZE);
+	if (len >= budget->limit / (budget->readers + !len))
+		return (ENOBUFS);
+	return (0);
+}
+
+/**
+ * @brief Sets the most bytes buffered across all readers.
+ * @param limit The cap in bytes, 0 for none. Lowering it below what is
+ * buffered already frees nothing: the heaviest readers are refused reads
+ * until they have consumed enough. Raising it lets a reader refused with
+ * EMSGSIZE read on.
+ * @note The cap is on pending bytes (read but not yet returned), not on the
+ * memory allocated for them. Size it with the storage's overhead in mind: a
+ * GNL_STORAGE_BUF or RING buffer doubles when it grows and is kept at that
+ * size until the reader is cleared, so it can hold up to about twice its
+ * pending bytes; a GNL_STORAGE_LIST store adds up to two partly used chunks
+ * (the last one and the spare) of at least BUFFER_SIZE bytes.
+ */
+void	gnl_set_budget(size_t limit)
+{
+	gnl_budget()->limit = limit;
+}
+
+/**
+ * @brief Returns the bytes buffered across all readers.
+ */
+size_t	gnl_budget_used(void)
+{
+	return (gnl_budget()->used);
+}
+
+#endif
@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_cache.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 17:46:10 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 16:52:31 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#define _GNU_SOURCE
+#include "get_next_line.h"
+#include <sys/stat.h>
+
+/*
+ * Page cache policies. A one-pass scan of a huge file otherwise fills the page
+ * cache with pages that will never be read again, evicting everybody else's.
+ * Once enabled with gnl_set_cache, every gnl_fill of the reader calls
+ * gnl_cache_step, which knows the file offset of the store from the bytes read
+ * so far:
+ * - GNL_CACHE_SEQUENTIAL: posix_fadvise(SEQUENTIAL) once, when enabled.
+ * - GNL_CACHE_READAHEAD: readahead() keeps GNL_READAHEAD bytes ahead of the
+ *   reads in flight, issued again each time half of the window is used.
+ * - GNL_CACHE_DROP: posix_fadvise(DONTNEED) on the pages already consumed, in
+ *   GNL_DROP_BLOCK steps, and on everything left at EOF.
+ * Pipes, sockets and terminals have no page cache: the policies are ignored.
+ */
+
+#define GNL_PAGE_MASK 4095
+
+/**
+ * @brief Hints the kernel to read [off, off + len) of a file in advance.
+ */
+void	gnl_read_ahead(int fd, off_t off, size_t len)
+{
+#ifdef __linux__
+	if (readahead(fd, off, len) == 0)
+		return ;
+#endif
+	posix_fadvise(fd, off, len, POSIX_FADV_WILLNEED);
+}
+
+/**
+ * @brief Enables page cache policies on the reader of a file descriptor.
+ * @param fd The file descriptor.
+ * @param policy A combination of GNL_CACHE_SEQUENTIAL, GNL_CACHE_READAHEAD and
+ * GNL_CACHE_DROP, or 0 to disable them.
+ * @return 0 on success (nothing is done for pipes, sockets and terminals), -1
+ * if fd is invalid.
+ * @note The policies stay until EOF, where they are reset.
+ */
+int	gnl_set_cache(int fd, int policy)
+{
+	t_gnl		*gnl;
+	struct stat	st;
+	off_t		pos;
+
+	gnl = gnl_get(fd);
+	if (!gnl || fstat(fd, &st) == -1)
+		return (-1);
+	gnl->cache = (t_cache){0};
+	pos = lseek(fd, 0, SEEK_CUR);
+	if (!policy || !S_ISREG(st.st_mode) || pos == -1)
+		return (0);
+	gnl->cache = (t_cache){policy, pos, pos, pos - gnl_store_len(&gnl->store)};
+	gnl->cache.dropped &= ~(off_t)GNL_PAGE_MASK;
+	if (policy & GNL_CACHE_SEQUENTIAL)
+		posix_fadvise(fd, pos, 0, POSIX_FADV_SEQUENTIAL);
+	if (policy & GNL_CACHE_READAHEAD)
+	{
+		gnl_read_ahead(fd, pos, GNL_READAHEAD);
+		gnl->cache.ahead = pos + GNL_READAHEAD;
+	}
+	return (0);
+}
+
+/**
+ * @brief Applies the reader's policies after a read.
+ * @param gnl The reader.
+ * @param fd The file descriptor that was read.
+ * @param bytes_read What the read returned: 0 means EOF.
+ */
+void	gnl_cache_step(t_gnl *gnl, int fd, ssize_t bytes_read)
+{
+	t_cache	*c;
+	off_t	used;
+
+	c = &gnl->cache;
+	c->pos += bytes_read;
+	if ((c->policy & GNL_CACHE_READAHEAD) && bytes_read
+		&& c->ahead - c->pos < GNL_READAHEAD / 2)
+	{
+		if (c->ahead < c->pos)
+			c->ahead = c->pos;
+		gnl_read_ahead(fd, c->ahead, c->pos + GNL_READAHEAD - c->ahead);
+		c->ahead = c->pos + GNL_READAHEAD;
+	}
+	used = (c->pos - gnl_store_len(&gnl->store)) & ~(off_t)GNL_PAGE_MASK;
+	if (!bytes_read)
+		used = c->pos;
+	if ((c->policy & GNL_CACHE_DROP) && used > c->dropped
+		&& (!bytes_read || used - c->dropped >= GNL_DROP_BLOCK))
+	{
+		posix_fadvise(fd, c->dropped, used - c->dropped, POSIX_FADV_DONTNEED);
+		c->dropped = used;
+	}
+	if (!bytes_read)
+		*c = (t_cache){0};
+}
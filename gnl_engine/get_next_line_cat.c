@@ -0,0 +1,191 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_cat.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 19:48:03 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 16:12:04 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+#include <errno.h>
+#include <glob.h>
+
+/*
+ * Several files read as one stream of lines, like cat file1 file2 | gnl.
+ * While a file is read, the next one is already open and being read ahead by
+ * the kernel, so the first read of each file does not start from a cold page
+ * cache. Each file is read by its own reader until EOF, so a file without a
+ * trailing newline ends with a line of its own: lines are never merged across
+ * a file boundary.
+ */
+
+/**
+ * @brief Opens a file of the list and asks the kernel to start reading it.
+ * @return The fd, or -1 if it cannot be opened.
+ * @note POSIX_FADV_WILLNEED only queues the reads, where readahead() would
+ * wait for them to be submitted: the current file is not held up.
+ */
+static int	prefetch(const char *path)
+{
+	int	fd;
+
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd != -1)
+		posix_fadvise(fd, 0, GNL_READAHEAD, POSIX_FADV_WILLNEED);
+	return (fd);
+}
+
+/**
+ * @brief Makes the prefetched file current and prefetches the one after.
+ * @return 0 on success, -1 if there are no files left (errno is 0) or the file
+ * cannot be opened (it is then skipped, errno is left by open).
+ */
+static int	open_file(t_gnl_cat *cat)
+{
+	if (cat->index >= cat->count)
+		return (errno = 0, -1);
+	cat->fd = cat->next;
+	if (cat->fd == -1)
+		cat->fd = open(cat->paths[cat->index], O_RDONLY | O_CLOEXEC);
+	cat->next = -1;
+	if (cat->index + 1 < cat->count)
+		cat->next = prefetch(cat->paths[cat->index + 1]);
+	if (cat->fd == -1)
+		return (cat->index++, -1);
+	gnl_set_cache(cat->fd, GNL_CACHE_SEQUENTIAL);
+	return (0);
+}
+
+/**
+ * @brief Closes the current file and drops its reader, as gnl_close does: the
+ * next file may get the same fd number, and must not inherit its state.
+ */
+static void	close_file(t_gnl_cat *cat)
+{
+	gnl_close(cat->fd);
+	cat->fd = -1;
+	cat->index++;
+}
+
+/**
+ * @brief Creates a reader over several files, read in the given order.
+ * @param paths The paths (copied).
+ * @param count The number of paths.
+ * @return The reader, or NULL if memory allocation fails. errno is EINVAL in
+ * single-reader builds (GNL_MULTI_FD 0): the files would share the reader of
+ * every other fd.
+ */
+t_gnl_cat	*gnl_cat_open(char *const *paths, size_t count)
+{
+	t_gnl_cat	*cat;
+	size_t		len;
+
+	if (!GNL_MULTI_FD)
+		return (errno = EINVAL, NULL);
+	cat = (t_gnl_cat *)malloc(sizeof(t_gnl_cat));
+	if (!cat)
+		return (NULL);
+	*cat = (t_gnl_cat){NULL, 0, 0, -1, -1};
+	cat->paths = (char **)malloc((count + 1) * sizeof(char *));
+	if (!cat->paths)
+		return (free(cat), NULL);
+	while (cat->count < count)
+	{
+		len = ft_strlen(paths[cat->count]) + 1;
+		cat->paths[cat->count] = (char *)malloc(len * sizeof(char));
+		if (!cat->paths[cat->count])
+			return (gnl_cat_close(cat), NULL);
+		ft_memcpy(cat->paths[cat->count], paths[cat->count], len);
+		cat->count++;
+	}
+	if (count)
+		cat->next = prefetch(cat->paths[0]);
+	return (cat);
+}
+
+/**
+ * @brief Creates a reader over the files matching a glob pattern, in
+ * alphabetical order (hourly logs named by date come out in time order).
+ * @param pattern The pattern, as for glob(3).
+ * @return The reader (over no files if nothing matches), or NULL if the
+ * pattern cannot be expanded or memory allocation fails (errno is EINVAL in
+ * single-reader builds, see gnl_cat_open).
+ */
+t_gnl_cat	*gnl_cat_glob(const char *pattern)
+{
+	glob_t		matches;
+	t_gnl_cat	*cat;
+	int			ret;
+
+	ret = glob(pattern, 0, NULL, &matches);
+	if (ret == GLOB_NOMATCH)
+		return (globfree(&matches), gnl_cat_open(NULL, 0));
+	if (ret != 0)
+		return (globfree(&matches), NULL);
+	cat = gnl_cat_open(matches.gl_pathv, matches.gl_pathc);
+	globfree(&matches);
+	return (cat);
+}
+
+/**
+ * @brief Returns the next line of the files.
+ * @param cat The reader.
+ * @return
+ * - A null-terminated string containing the line read, with its newline if it
+ *   has one (the last line of each file may not).
+ *
+ * - NULL with errno 0 at the end of the last file.
+ *
+ * - NULL with errno set on error: a file that cannot be opened or read, or
+ *   memory allocation failure. The next call goes on with the next file,
+ *   except if the memory budget refused the read (errno is ENOBUFS or
+ *   EMSGSIZE) or a line could not be allocated: it then goes on with the same
+ *   file.
+ * @warning The returned string must be freed by the caller.
+ */
+char	*gnl_cat_next_line(t_gnl_cat *cat)
+{
+	t_gnl	*gnl;
+	ssize_t	len;
+
+	if (!cat || BUFFER_SIZE <= 0)
+		return (errno = EINVAL, NULL);
+	while (1)
+	{
+		if (cat->fd == -1 && open_file(cat) == -1)
+			return (NULL);
+		gnl = gnl_get(cat->fd);
+		if (!gnl)
+			return (close_file(cat), errno = EMFILE, NULL);
+		len = gnl_line_len(gnl, cat->fd);
+		if (len > 0)
+			return (gnl_take(gnl, len));
+		if (len == -1 && gnl->refused)
+			return (NULL);
+		close_file(cat);
+		if (len == -1)
+			return (NULL);
+	}
+}
+
+/**
+ * @brief Closes the files of a reader and frees it.
+ * @param cat The reader.
+ */
+void	gnl_cat_close(t_gnl_cat *cat)
+{
+	if (!cat)
+		return ;
+	if (cat->fd != -1)
+		close_file(cat);
+	if (cat->next != -1)
+		close(cat->next);
+	while (cat->count)
+		free(cat->paths[--cat->count]);
+	free(cat->paths);
+	free(cat);
+}
@@ -0,0 +1,393 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_copy.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:31:12 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 15:41:18 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#define _GNU_SOURCE
+#include "get_next_line.h"
+#include <errno.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#ifdef __linux__
+# include <fcntl.h>
+# include <sys/sendfile.h>
+#endif
+
+/*
+ * Line forwarding. The reader's store is only used to find line boundaries;
+ * the bytes themselves go from fd_in to fd_out inside the kernel:
+ * - Regular file input: lines are read into the store to be scanned, then
+ *   copy_file_range (or sendfile) copies them from the file at their offset.
+ * - Pipe input: tee duplicates what is in the pipe into a private pipe that is
+ *   read to be scanned, then splice moves the complete lines out of fd_in.
+ * - Anything else, or if the kernel refuses: write straight from the store.
+ * No line is ever allocated.
+ */
+
+/**
+ * @brief State of one gnl_copy_lines_if call.
+ * - left: Lines still to copy (SIZE_MAX when there is no limit).
+ * - copied: Lines written to fd_out so far.
+ * - run_lines: Lines in the run find_run last measured, counted by count_run
+ *   once the run is transferred.
+ * - pos: File offset of the first pending byte of the store (regular files).
+ * - method: 0 copy_file_range, 1 sendfile, 2 write from the store.
+ * - pipe: Private pipe used to peek into a pipe input, or -1 if not used.
+ */
+typedef struct s_copy
+{
+	t_gnl			*gnl;
+	int				in;
+	int				out;
+	size_t			left;
+	size_t			copied;
+	size_t			run_lines;
+	off_t			pos;
+	int				method;
+	int				pipe[2];
+	char			*peek;
+	t_gnl_filter	filter;
+}	t_copy;
+
+/**
+ * @brief Finds the longest run of lines at the start of `data` that the filter
+ * either all keeps or all drops, without going past the line limit.
+ * @param c The copy state. `c->run_lines` is set to the lines of the run.
+ * @param data The bytes to scan.
+ * @param len The number of bytes to scan.
+ * @param keep Out: whether the lines of the run are kept.
+ * @return The length of the run in bytes. Only complete lines are counted,
+ * except a first line without newline, which callers only pass at EOF.
+ */
+static size_t	find_run(t_copy *c, const char *data, size_t len, int *keep)
+{
+	size_t	run;
+	size_t	line;
+	size_t	lines;
+	char	*nl;
+	int		kept;
+
+	run = 0;
+	lines = 0;
+	while (run < len && lines < c->left)
+	{
+		nl = ft_memchr(data + run, '\n', len - run);
+		if (!nl && run)
+			break ;
+		line = len - run;
+		if (nl)
+			line = nl - (data + run) + 1;
+		kept = !c->filter.keep
+			|| c->filter.keep(data + run, line, c->filter.userdata);
+		if (lines && kept != *keep)
+			break ;
+		*keep = kept;
+		run += line;
+		lines++;
+	}
+	c->run_lines = lines;
+	return (run);
+}
+
+/**
+ * @brief Counts the run find_run measured, once it has been transferred.
+ * @param c The copy state.
+ * @param keep Whether the lines of the run were kept.
+ */
+static void	count_run(t_copy *c, int keep)
+{
+	c->left -= c->run_lines;
+	if (keep)
+		c->copied += c->run_lines;
+	c->run_lines = 0;
+}
+
+/**
+ * @brief Writes a whole buffer, retrying after partial writes.
+ * @return 0 on success, -1 on write error.
+ */
+static int	write_all(int fd, const char *data, size_t len)
+{
+	ssize_t	written;
+
+	while (len)
+	{
+		written = write(fd, data, len);
+		if (written == -1 && errno == EINTR)
+			continue ;
+		if (written <= 0)
+			return (-1);
+		data += written;
+		len -= written;
+	}
+	return (0);
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Copies `len` bytes of the input file, from `c->pos`, to the output
+ * inside the kernel.
+ * @return The number of bytes copied. Less than `len` means the current method
+ * stopped working for these fds; the caller writes the rest from the store.
+ */
+static size_t	kernel_copy(t_copy *c, size_t len)
+{
+	off_t	off;
+	ssize_t	moved;
+
+	off = c->pos;
+	while (c->method < 2 && (size_t)(off - c->pos) < len)
+	{
+		if (c->method == 0)
+			moved = copy_file_range(c->in, &off, c->out, NULL,
+					len - (off - c->pos), 0);
+		else
+			moved = sendfile(c->out, c->in, &off, len - (off - c->pos));
+		if (moved == -1 && errno == EINTR)
+			continue ;
+		if (moved <= 0)
+			c->method++;
+	}
+	return (off - c->pos);
+}
+
+/**
+ * @brief Moves `len` bytes from the input pipe to the output, or drops them.
+ * @return 0 on success, -1 on error.
+ * @note If splice refuses the output (e.g. O_APPEND files), the bytes are read
+ * into the peek buffer, which is large enough since they were peeked, and
+ * written from there.
+ */
+static int	splice_out(t_copy *c, size_t len, int keep)
+{
+	ssize_t	moved;
+
+	while (len && keep)
+	{
+		moved = splice(c->in, NULL, c->out, NULL, len, SPLICE_F_MOVE);
+		if (moved == -1 && errno == EINTR)
+			continue ;
+		if (moved <= 0)
+			break ;
+		len -= moved;
+	}
+	while (len)
+	{
+		moved = read(c->in, c->peek, len);
+		if (moved == -1 && errno == EINTR)
+			continue ;
+		if (moved <= 0 || (keep && write_all(c->out, c->peek, moved) == -1))
+			return (-1);
+		len -= moved;
+	}
+	return (0);
+}
+
+#else
+
+static size_t	kernel_copy(t_copy *c, size_t len)
+{
+	(void)len;
+	c->method = 2;
+	return (0);
+}
+
+#endif
+
+/**
+ * @brief Forwards the next run of lines through the reader's store.
+ * @return 1 to go on, 0 at EOF, -1 on error.
+ */
+static int	store_step(t_copy *c)
+{
+	ssize_t	len;
+	size_t	run;
+	size_t	done;
+	char	*data;
+	int		keep;
+
+	len = gnl_line_len(c->gnl, c->in);
+	if (len <= 0)
+		return ((int)len);
+	data = gnl_store_data(&c->gnl->store);
+	if (!data)
+		return (-1);
+	keep = 0;
+	run = find_run(c, data, gnl_store_len(&c->gnl->store), &keep);
+	done = 0;
+	if (keep && c->method < 2)
+		done = kernel_copy(c, run);
+	if (keep && write_all(c->out, data + done, run - done) == -1)
+		return (-1);
+	count_run(c, keep);
+	gnl_store_consume(&c->gnl->store, run);
+	c->pos += run;
+	return (1);
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Forwards the next run of lines of a pipe with tee and splice.
+ * @return 1 to go on, 0 at EOF, -1 on error (lines are only counted once
+ * they are transferred).
+ * @note If what is in the pipe holds no complete line, it is left to
+ * store_step to read the line the usual way.
+ */
+static int	pipe_step(t_copy *c)
+{
+	ssize_t	peeked;
+	ssize_t	got;
+	size_t	run;
+	int		keep;
+
+	peeked = tee(c->in, c->pipe[1], GNL_PEEK_SIZE, 0);
+	if (peeked == -1 && errno == EINTR)
+		return (1);
+	if (peeked == -1)
+		return (close(c->pipe[0]), close(c->pipe[1]), c->pipe[0] = -1, 1);
+	if (peeked == 0)
+		return (0);
+	run = 0;
+	while (run < (size_t)peeked)
+	{
+		got = read(c->pipe[0], c->peek + run, peeked - run);
+		if (got <= 0)
+			return (-1);
+		run += got;
+	}
+	if (!ft_memchr(c->peek, '\n', peeked))
+		return (store_step(c));
+	keep = 0;
+	run = find_run(c, c->peek, peeked, &keep);
+	if (splice_out(c, run, keep) == -1)
+		return (-1);
+	count_run(c, keep);
+	return (1);
+}
+
+/**
+ * @brief Prepares the private pipe and peek buffer if the input is a pipe.
+ */
+static void	pipe_setup(t_copy *c, struct stat *in)
+{
+	c->pipe[0] = -1;
+	if (!S_ISFIFO(in->st_mode))
+		return ;
+	c->peek = (char *)malloc(GNL_PEEK_SIZE * sizeof(char));
+	if (c->peek && pipe2(c->pipe, O_CLOEXEC) == -1)
+		c->pipe[0] = -1;
+	if (c->pipe[0] != -1 && fcntl(c->pipe[1], F_SETPIPE_SZ, GNL_PEEK_SIZE) == -1
+		&& fcntl(c->pipe[1], F_GETPIPE_SZ) < GNL_PEEK_SIZE)
+		(close(c->pipe[0]), close(c->pipe[1]), c->pipe[0] = -1);
+}
+
+#else
+
+static int	pipe_step(t_copy *c)
+{
+	return (store_step(c));
+}
+
+static void	pipe_setup(t_copy *c, struct stat *in)
+{
+	(void)in;
+	c->pipe[0] = -1;
+}
+
+#endif
+
+/**
+ * @brief Picks how bytes will be moved, from the types of both fds.
+ * @return 0 on success, -1 if either fd cannot be inspected.
+ */
+static int	copy_setup(t_copy *c)
+{
+	struct stat	in;
+	struct stat	out;
+
+	if (fstat(c->in, &in) == -1 || fstat(c->out, &out) == -1)
+		return (-1);
+	c->method = 2;
+	c->pos = 0;
+	if (S_ISREG(in.st_mode))
+	{
+		c->pos = lseek(c->in, 0, SEEK_CUR);
+		c->method = !S_ISREG(out.st_mode);
+		if (c->pos == -1)
+			c->method = 2;
+		c->pos -= gnl_store_len(&c->gnl->store);
+	}
+	pipe_setup(c, &in);
+	return (0);
+}
+
+/**
+ * @brief Forwards whole lines from one fd to another, keeping only the lines
+ * a filter accepts.
+ * @param fd_in The file descriptor to read lines from.
+ * @param fd_out The file descriptor to write them to.
+ * @param n_lines The number of lines to forward (kept or not), 0 for all of
+ * them up to EOF.
+ * @param filter `filter.keep(line, len, filter.userdata)` returns nonzero for
+ * the lines to forward; the line is a view into the scan buffer, newline
+ * included. With a NULL `keep` every line is forwarded.
+ * @return The number of lines written to fd_out, or -1 on error.
+ * @note Lines already buffered by get_next_line for fd_in are forwarded first,
+ * and once n_lines is reached the rest stays buffered for the next call.
+ * Consecutive kept lines are moved in a single transfer. fd_in is read by the
+ * kernel, so a source (see gnl_open_source) fails with EINVAL.
+ */
+ssize_t	gnl_copy_lines_if(int fd_in, int fd_out, size_t n_lines,
+		t_gnl_filter filter)
+{
+	t_copy	c;
+	int		status;
+
+	c = (t_copy){gnl_get(fd_in), fd_in, fd_out, n_lines, 0, 0, 0, 2,
+		{-1, -1}, NULL, filter};
+	if (c.gnl && c.gnl->source)
+		return (errno = EINVAL, -1);
+	if (!c.gnl || fd_out < 0 || BUFFER_SIZE <= 0 || copy_setup(&c) == -1)
+		return (-1);
+	if (!n_lines)
+		c.left = SIZE_MAX;
+	status = 1;
+	while (status > 0 && c.left)
+	{
+		if (c.pipe[0] != -1 && !gnl_store_len(&c.gnl->store))
+			status = pipe_step(&c);
+		else
+			status = store_step(&c);
+	}
+	if (c.pipe[0] != -1)
+		(close(c.pipe[0]), close(c.pipe[1]));
+	free(c.peek);
+	if (status <= 0)
+		gnl_clear(c.gnl);
+	if (status == -1)
+		return (-1);
+	return (c.copied);
+}
+
+/**
+ * @brief Forwards whole lines from one fd to another.
+ * @param fd_in The file descriptor to read lines from.
+ * @param fd_out The file descriptor to write them to.
+ * @param n_lines The number of lines to forward, 0 for all of them up to EOF.
+ * @return The number of lines forwarded, or -1 on error.
+ * @note See gnl_copy_lines_if.
+ */
+ssize_t	gnl_copy_lines(int fd_in, int fd_out, size_t n_lines)
+{
+	return (gnl_copy_lines_if(fd_in, fd_out, n_lines,
+			(t_gnl_filter){NULL, NULL}));
+}
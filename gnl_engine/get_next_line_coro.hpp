@@ -0,0 +1,582 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_coro.hpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 04:07:15 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 17:36:42 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef GET_NEXT_LINE_CORO_HPP
+# define GET_NEXT_LINE_CORO_HPP
+
+# include <cerrno>
+# include <coroutine>
+# include <exception>
+# include <iterator>
+# include <memory>
+# include <new>
+# include <optional>
+# include <string_view>
+# include <utility>
+# include <sys/epoll.h>
+# include "get_next_line.hpp"
+
+/* ************************************************************************** */
+/*
+ * C++20 coroutines over the line readers of get_next_line.hpp (Linux only for
+ * the async part, which uses epoll):
+ *
+ * - gnl::lines(fd): A generator, for (std::string_view line : gnl::lines(fd)),
+ *   blocking in read() like LineReader but resumable from anywhere.
+ * - gnl::next_line(reactor, reader): An awaitable: on a non-blocking fd,
+ *   co_await suspends the coroutine until the fd is readable instead of
+ *   blocking, so one thread serves many connections. The engine keeps the
+ *   bytes of an incomplete line across EAGAIN, so nothing is copied aside.
+ * - gnl::Reactor: The epoll loop that resumes the suspended coroutines.
+ * - gnl::Detached: A fire-and-forget coroutine type, to run one per fd.
+ *
+ * Coroutine frames are allocated from a per-thread pool of size classes, so
+ * starting a coroutine per line or per connection does not go to malloc once
+ * the pool is warm. Many fds at once need a GNL_MULTI_FD build.
+ */
+/* ************************************************************************** */
+
+namespace gnl
+{
+
+namespace detail
+{
+
+/**
+ * @brief Free lists of coroutine frames by size class (multiples of GRAIN
+ * bytes, up to GRAIN * CLASSES); larger frames go to operator new.
+ * @note One pool per thread: a frame freed on another thread than the one
+ * that allocated it goes to the pool of the freeing thread.
+ */
+class FramePool
+{
+public:
+	static constexpr size_t	GRAIN = 64;
+	static constexpr size_t	CLASSES = 32;
+
+	FramePool() noexcept : free_()
+	{
+	}
+
+	FramePool(const FramePool &) = delete;
+	FramePool	&operator=(const FramePool &) = delete;
+
+	~FramePool()
+	{
+		for (Node *&head : free_)
+		{
+			while (head)
+				::operator delete(std::exchange(head, head->next));
+		}
+	}
+
+	void	*get(size_t size)
+	{
+		size_t	c;
+
+		c = (size + GRAIN - 1) / GRAIN - 1;
+		if (c >= CLASSES)
+			return (::operator new(size));
+		if (free_[c])
+			return (std::exchange(free_[c], free_[c]->next));
+		return (::operator new((c + 1) * GRAIN));
+	}
+
+	void	put(void *frame, size_t size) noexcept
+	{
+		size_t	c;
+
+		c = (size + GRAIN - 1) / GRAIN - 1;
+		if (c >= CLASSES)
+			return (::operator delete(frame));
+		free_[c] = new (frame) Node{free_[c]};
+	}
+
+	static FramePool	&local() noexcept
+	{
+		thread_local FramePool	pool;
+
+		return (pool);
+	}
+
+private:
+	struct Node
+	{
+		Node	*next;
+	};
+
+	Node	*free_[CLASSES];
+};
+
+}
+
+/**
+ * @brief Base of the promise types below: their frames come from the pool.
+ */
+struct PooledFrame
+{
+	static void	*operator new(size_t size)
+	{
+		return (detail::FramePool::local().get(size));
+	}
+
+	static void	operator delete(void *frame, size_t size) noexcept
+	{
+		detail::FramePool::local().put(frame, size);
+	}
+};
+
+/**
+ * @brief A lazy generator: the body runs up to each co_yield when iterated.
+ * @note The yielded value is referenced, not copied: it is valid until the
+ * iterator is advanced.
+ */
+template <class T>
+class Generator
+{
+public:
+	struct promise_type : PooledFrame
+	{
+		const T	*value = nullptr;
+
+		Generator	get_return_object() noexcept
+		{
+			return (Generator(handle::from_promise(*this)));
+		}
+
+		std::suspend_always	initial_suspend() noexcept
+		{
+			return (std::suspend_always());
+		}
+
+		std::suspend_always	final_suspend() noexcept
+		{
+			return (std::suspend_always());
+		}
+
+		std::suspend_always	yield_value(const T &v) noexcept
+		{
+			value = std::addressof(v);
+			return (std::suspend_always());
+		}
+
+		void	return_void() noexcept
+		{
+		}
+
+		void	unhandled_exception()
+		{
+			throw ;
+		}
+	};
+
+	using handle = std::coroutine_handle<promise_type>;
+
+	class iterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+
+		iterator() noexcept : h_(nullptr)
+		{
+		}
+
+		explicit iterator(handle h) noexcept : h_(h)
+		{
+		}
+
+		const T	&operator*() const noexcept
+		{
+			return (*h_.promise().value);
+		}
+
+		iterator	&operator++()
+		{
+			h_.resume();
+			return (*this);
+		}
+
+		void	operator++(int)
+		{
+			++*this;
+		}
+
+		bool	operator==(std::default_sentinel_t) const noexcept
+		{
+			return (!h_ || h_.done());
+		}
+
+	private:
+		handle	h_;
+	};
+
+	explicit Generator(handle h) noexcept : h_(h)
+	{
+	}
+
+	Generator(Generator &&other) noexcept : h_(std::exchange(other.h_, {}))
+	{
+	}
+
+	Generator	&operator=(Generator &&other) noexcept
+	{
+		if (this != &other)
+		{
+			if (h_)
+				h_.destroy();
+			h_ = std::exchange(other.h_, {});
+		}
+		return (*this);
+	}
+
+	~Generator()
+	{
+		if (h_)
+			h_.destroy();
+	}
+
+	iterator	begin()
+	{
+		if (h_)
+			h_.resume();
+		return (iterator(h_));
+	}
+
+	std::default_sentinel_t	end() const noexcept
+	{
+		return (std::default_sentinel);
+	}
+
+private:
+	handle	h_;
+};
+
+/**
+ * @brief Yields the lines of reader (newline included) until EOF or an error,
+ * then closes it as its destructor would.
+ */
+inline Generator<std::string_view>	lines(LineReader reader)
+{
+	std::string_view	line;
+
+	while (reader.next(line))
+		co_yield line;
+}
+
+/**
+ * @brief Yields the lines of fd, which is closed at the end (or when the
+ * generator is destroyed).
+ */
+inline Generator<std::string_view>	lines(int fd)
+{
+	return (lines(LineReader(fd)));
+}
+
+/**
+ * @brief A coroutine that starts at once and frees itself when it returns;
+ * whoever starts it never waits for it.
+ */
+struct Detached
+{
+	struct promise_type : PooledFrame
+	{
+		Detached	get_return_object() noexcept
+		{
+			return (Detached());
+		}
+
+		std::suspend_never	initial_suspend() noexcept
+		{
+			return (std::suspend_never());
+		}
+
+		std::suspend_never	final_suspend() noexcept
+		{
+			return (std::suspend_never());
+		}
+
+		void	return_void() noexcept
+		{
+		}
+
+		void	unhandled_exception() noexcept
+		{
+			std::terminate();
+		}
+	};
+};
+
+/**
+ * @brief Something waiting for a fd to become readable: ready is called by
+ * Reactor::run once it is.
+ */
+struct Waiter
+{
+	int		fd;
+	void	(*ready)(Waiter *self);
+};
+
+/**
+ * @brief An epoll loop: each watched fd is armed once (EPOLLONESHOT), and its
+ * waiter is called when the fd is readable or hung up.
+ */
+class Reactor
+{
+public:
+	Reactor() noexcept : epfd_(epoll_create1(EPOLL_CLOEXEC)), waiting_(0)
+	{
+	}
+
+	Reactor(const Reactor &) = delete;
+	Reactor	&operator=(const Reactor &) = delete;
+
+	~Reactor()
+	{
+		if (epfd_ >= 0)
+			close(epfd_);
+	}
+
+	bool	valid() const noexcept
+	{
+		return (epfd_ >= 0);
+	}
+
+	/**
+	 * @brief Arms w->fd for one readiness event.
+	 * @return false (errno set) if the fd cannot be watched, e.g. a regular
+	 * file, which never blocks anyway.
+	 */
+	bool	watch(Waiter *w) noexcept
+	{
+		epoll_event	ev;
+
+		ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+		ev.data.ptr = w;
+		if (epoll_ctl(epfd_, EPOLL_CTL_MOD, w->fd, &ev) == -1
+			&& (errno != ENOENT
+				|| epoll_ctl(epfd_, EPOLL_CTL_ADD, w->fd, &ev) == -1))
+			return (false);
+		waiting_++;
+		return (true);
+	}
+
+	/**
+	 * @brief Calls the waiters of the fds that become readable, until none is
+	 * left waiting.
+	 * @return 0, or -1 if epoll_wait fails (errno set).
+	 */
+	int	run() noexcept
+	{
+		epoll_event	events[64];
+		int			n;
+
+		while (waiting_)
+		{
+			n = epoll_wait(epfd_, events, 64, -1);
+			if (n == -1 && errno == EINTR)
+				continue ;
+			if (n == -1)
+				return (-1);
+			for (int i = 0; i < n; i++)
+			{
+				Waiter	*w = static_cast<Waiter *>(events[i].data.ptr);
+
+				waiting_--;
+				w->ready(w);
+			}
+		}
+		return (0);
+	}
+
+private:
+	int		epfd_;
+	size_t	waiting_;
+};
+
+/**
+ * @brief Awaitable returned by next_line: completes with the next line, or
+ * std::nullopt at EOF or on error (reader.error() tells which).
+ */
+class LineAwaiter : private Waiter
+{
+public:
+	LineAwaiter(Reactor &reactor, LineReader &reader) noexcept
+		: Waiter{reader.fd(), &LineAwaiter::on_ready}, reactor_(reactor),
+		reader_(reader), got_(false)
+	{
+	}
+
+	bool	await_ready() noexcept
+	{
+		return (try_next());
+	}
+
+	bool	await_suspend(std::coroutine_handle<> h) noexcept
+	{
+		h_ = h;
+		return (reactor_.watch(this));
+	}
+
+	std::optional<std::string_view>	await_resume() const noexcept
+	{
+		if (!got_)
+			return (std::nullopt);
+		return (line_);
+	}
+
+private:
+	/** @brief Reads the line if it is complete; false if the fd would block. */
+	bool	try_next() noexcept
+	{
+		got_ = reader_.next(line_);
+		return (got_ || reader_.error() != EAGAIN);
+	}
+
+	static void	on_ready(Waiter *self)
+	{
+		LineAwaiter	*a = static_cast<LineAwaiter *>(self);
+
+		if (a->try_next() || !a->reactor_.watch(a))
+			a->h_.resume();
+	}
+
+	Reactor					&reactor_;
+	LineReader				&reader_;
+	std::string_view		line_;
+	bool					got_;
+	std::coroutine_handle<>	h_;
+};
+
+/**
+ * @brief co_await next_line(reactor, reader): the next line of a non-blocking
+ * fd, suspending the coroutine while the fd has nothing to read.
+ */
+inline LineAwaiter	next_line(Reactor &reactor, LineReader &reader) noexcept
+{
+	return (LineAwaiter(reactor, reader));
+}
+
+}
+
+#endif
+
+/* ************************************************************************** */
+/* UNCOMMENT FOR TESTING, benchmark against a blocking thread per fd:
+ * F="-D GNL_MULTI_FD=1 -D MAX_FD=4096 -D GNL_STATS=0 -D GNL_BUDGET=0
+ *    -D GNL_CHECK_REUSE=0"
+ * cc -O2 -c $F get_next_line*.c
+ * c++ -std=c++20 -O2 $F main.cpp *.o -pthread
+ * 256 socketpairs of 2000 lines each, BUFFER_SIZE=64: about 2.0-2.8 s with a
+ * thread per fd, 0.7-1.0 s with coroutines on one thread.
+ * The baseline calls the engine from 256 threads at once, which is only safe
+ * because each touches the reader of its own fd and nothing else: the latency
+ * histograms, the memory budget and the reuse generation are process-wide and
+ * not atomic, so GNL_STATS, GNL_BUDGET and GNL_CHECK_REUSE must stay 0.
+ */
+/* ************************************************************************** */
+
+/*
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+#include "get_next_line_coro.hpp"
+
+#define CONNS 256
+#define LINES 2000
+
+static std::atomic<size_t>	g_lines;
+
+static void	write_all(std::vector<int> &out)
+{
+	const char	msg[] = "GET /index.html HTTP/1.1 host: example\n";
+
+	for (int i = 0; i < LINES; i++)
+		for (int fd : out)
+			if (write(fd, msg, sizeof(msg) - 1) < 0)
+				return ;
+	for (int fd : out)
+		close(fd);
+}
+
+static gnl::Detached	serve(gnl::Reactor &reactor, int fd)
+{
+	gnl::LineReader	reader(fd);
+
+	while (co_await gnl::next_line(reactor, reader))
+		g_lines++;
+}
+
+static double	bench(bool async)
+{
+	std::vector<int>		in;
+	std::vector<int>		out;
+	std::vector<std::thread>	threads;
+	int						sv[2];
+
+	for (int i = 0; i < CONNS; i++)
+	{
+		socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+		in.push_back(sv[0]);
+		out.push_back(sv[1]);
+	}
+	auto	start = std::chrono::steady_clock::now();
+	std::thread	writer(write_all, std::ref(out));
+	if (async)
+	{
+		gnl::Reactor	reactor;
+
+		for (int fd : in)
+		{
+			fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+			serve(reactor, fd);
+		}
+		reactor.run();
+	}
+	else
+	{
+		for (int fd : in)
+			threads.emplace_back([fd] {
+				for (std::string_view line : gnl::LineReader(fd))
+					g_lines += !line.empty();
+			});
+		for (std::thread &t : threads)
+			t.join();
+	}
+	writer.join();
+	return (std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count());
+}
+
+int	main(void)
+{
+	double	t;
+	size_t	n;
+
+	n = 0;
+	for (std::string_view line : gnl::lines(open(__FILE__, O_RDONLY)))
+		n += !line.empty();
+	printf("generator:     %zu non-empty lines in %s\n", n, __FILE__);
+	g_lines = 0;
+	t = bench(false);
+	printf("thread per fd: %zu lines in %.3f s\n", g_lines.load(), t);
+	g_lines = 0;
+	t = bench(true);
+	printf("coroutines:    %zu lines in %.3f s\n", g_lines.load(), t);
+	return (0);
+}
+*/
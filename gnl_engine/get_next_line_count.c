@@ -0,0 +1,145 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_count.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:41:27 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 15:41:18 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+#include <errno.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Running totals of a count: newlines seen, bytes seen and the last
+ * byte seen, which tells whether a final line lacks its newline.
+ */
+typedef struct s_count
+{
+	size_t			newlines;
+	size_t			bytes;
+	unsigned char	last;
+}	t_count;
+
+/**
+ * @brief Counts the newlines of up to `len` bytes of a file descriptor, in
+ * blocks of GNL_COUNT_BLOCK bytes.
+ * @param fd The file descriptor.
+ * @param off Where to start with pread, or -1 to read from the current
+ * position, which then moves to the end of what was counted.
+ * @param len The most bytes to count.
+ * @param count The totals to add to.
+ * @return 0 on success, -1 on read error or memory allocation failure.
+ */
+static int	count_blocks(int fd, off_t off, size_t len, t_count *count)
+{
+	char	*block;
+	ssize_t	got;
+	size_t	want;
+
+	block = (char *)malloc(GNL_COUNT_BLOCK * sizeof(char));
+	if (!block)
+		return (-1);
+	got = 1;
+	while (len && got)
+	{
+		want = GNL_COUNT_BLOCK;
+		if (want > len)
+			want = len;
+		if (off >= 0)
+			got = pread(fd, block, want, off);
+		else
+			got = read(fd, block, want);
+		if (got == -1 && errno != EINTR)
+			return (free(block), -1);
+		if (got <= 0)
+			continue ;
+		count->newlines += ft_memcount(block, '\n', got);
+		count->bytes += got;
+		count->last = block[got - 1];
+		len -= got;
+		off += (off >= 0) * got;
+	}
+	return (free(block), 0);
+}
+
+/**
+ * @brief Counts the lines left in a file descriptor without returning them.
+ * @param fd The file descriptor.
+ * @return The number of lines get_next_line would still return, a last line
+ * without newline included, or -1 on error.
+ * @note
+ * - Lines already buffered by get_next_line for fd are counted too.
+ *
+ * - Seekable fds are counted with pread: neither the file position nor the
+ *   buffered lines change, so the lines can still be read afterwards. Pipes
+ *   and sockets are read to EOF, and their buffered lines are dropped.
+ *
+ * - No line is allocated; one block of GNL_COUNT_BLOCK bytes is, per call.
+ *
+ * - The kernel is read directly, so a source (see gnl_open_source) fails with
+ *   EINVAL.
+ */
+ssize_t	gnl_count_lines(int fd)
+{
+	t_gnl	*gnl;
+	t_count	count;
+	char	*data;
+	off_t	off;
+
+	gnl = gnl_get(fd);
+	if (!gnl)
+		return (-1);
+	if (gnl->source)
+		return (errno = EINVAL, -1);
+	count = (t_count){0, gnl_store_len(&gnl->store), 0};
+	if (count.bytes)
+	{
+		data = gnl_store_data(&gnl->store);
+		if (!data)
+			return (-1);
+		count.newlines = ft_memcount(data, '\n', count.bytes);
+		count.last = data[count.bytes - 1];
+	}
+	off = lseek(fd, 0, SEEK_CUR);
+	if (count_blocks(fd, off, SIZE_MAX, &count) == -1)
+		return (-1);
+	if (off == -1)
+		gnl_store_clear(&gnl->store);
+	return (count.newlines + (count.bytes && count.last != '\n'));
+}
+
+/**
+ * @brief Counts the lines in a byte range of a seekable file descriptor.
+ * @param fd The file descriptor.
+ * @param off The offset of the first byte of the range.
+ * @param len The length of the range.
+ * @return The number of newlines in the range, plus one if the range ends the
+ * file with a line that has no newline, or -1 on error.
+ * @note The counts of ranges that split a file add up to its line count, so
+ * work can be sized per range. The fd's position and reader are untouched. A
+ * source fails with EINVAL.
+ */
+ssize_t	gnl_count_lines_range(int fd, off_t off, size_t len)
+{
+	t_count		count;
+	struct stat	st;
+	t_gnl		*gnl;
+
+	gnl = gnl_slot(fd);
+	if (gnl && gnl->source)
+		return (errno = EINVAL, -1);
+	if (fd < 0 || off < 0 || fstat(fd, &st) == -1)
+		return (-1);
+	count = (t_count){0, 0, 0};
+	if (count_blocks(fd, off, len, &count) == -1)
+		return (-1);
+	if (off + (off_t)count.bytes < st.st_size)
+		return (count.newlines);
+	return (count.newlines + (count.bytes && count.last != '\n'));
+}
@@ -0,0 +1,251 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_dedup.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 20:41:19 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/20 00:41:27 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+
+/*
+ * Line deduplication. Each line is hashed by the same pass that looks for its
+ * newline (ft_memchr_hash), and the hash is looked up in a linear probing
+ * table kept at most 3/4 full. Without exact, a line costs 8 to 16 bytes of
+ * table whatever its length; with exact, its bytes are also copied once into
+ * an arena, where a matching hash is compared in full.
+ * A line is compared without its newline, so a last line without one is a
+ * duplicate of the same line with one.
+ */
+
+#define SEED 0x243F6A8885A308D3ULL
+#define FIRST_CAP 1024
+
+/**
+ * @brief Finishes the hash of a line, mixing in its length.
+ * @return The hash, never 0 (the empty slot mark).
+ */
+static uint64_t	finish(uint64_t h, size_t len)
+{
+	h ^= len * 0x9E3779B97F4A7C15ULL;
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDULL;
+	h ^= h >> 33;
+	h *= 0xC4CEB9FE1A85EC53ULL;
+	h ^= h >> 33;
+	return (h + !h);
+}
+
+/**
+ * @brief Reads until the next line is complete, hashing it on the way.
+ * @param gnl The reader.
+ * @param fd The file descriptor to read from.
+ * @param h Out: the finished hash of the line, newline excluded.
+ * @return The length of the line, newline included, the number of pending
+ * bytes at EOF (0 if none), or -1 on read error or memory allocation failure.
+ * @note Only the bytes of a line that were not hashed yet are scanned after
+ * each read, as in gnl_line_len.
+ */
+static ssize_t	hash_line(t_gnl *gnl, int fd, uint64_t *h)
+{
+	const char	*data;
+	size_t		hashed;
+	ssize_t		i_nl;
+	ssize_t		bytes_read;
+	char		tail[8];
+
+	*h = SEED;
+	hashed = 0;
+	bytes_read = 1;
+	while (bytes_read > 0)
+	{
+		data = gnl_store_data(&gnl->store);
+		i_nl = -1;
+		if (data)
+			i_nl = ft_memchr_hash(data + hashed,
+					gnl_store_len(&gnl->store) - hashed, h);
+		if (i_nl >= 0)
+			return (*h = finish(*h, hashed + i_nl), hashed + i_nl + 1);
+		hashed += (gnl_store_len(&gnl->store) - hashed) & ~(size_t)7;
+		bytes_read = gnl_fill(gnl, fd);
+	}
+	if (bytes_read == -1 || !gnl_store_len(&gnl->store))
+		return (bytes_read);
+	i_nl = gnl_store_len(&gnl->store) - hashed;
+	ft_memcpy(tail, gnl_store_data(&gnl->store) + hashed, i_nl);
+	tail[i_nl] = '\n';
+	ft_memchr_hash(tail, i_nl + 1, h);
+	*h = finish(*h, hashed + i_nl);
+	return (hashed + i_nl);
+}
+
+/**
+ * @brief Looks a line up in the set.
+ * @return The index of the empty slot where the line goes, or -1 if the line
+ * is already in the set.
+ */
+static ssize_t	find_slot(const t_gnl_dedup *set, uint64_t h, const char *line,
+		size_t len)
+{
+	size_t	i;
+
+	i = h & (set->cap - 1);
+	while (set->hashes[i])
+	{
+		if (set->hashes[i] == h && (!set->exact
+				|| (set->spans[2 * i + 1] == len
+					&& !ft_memcmp(set->arena + set->spans[2 * i], line, len))))
+			return (-1);
+		i = (i + 1) & (set->cap - 1);
+	}
+	return (i);
+}
+
+/**
+ * @brief Moves slot i of a table to the same line's slot in a bigger one.
+ */
+static void	move_slot(t_gnl_dedup *to, const t_gnl_dedup *from, size_t i)
+{
+	size_t	j;
+
+	j = from->hashes[i] & (to->cap - 1);
+	while (to->hashes[j])
+		j = (j + 1) & (to->cap - 1);
+	to->hashes[j] = from->hashes[i];
+	if (from->exact)
+	{
+		to->spans[2 * j] = from->spans[2 * i];
+		to->spans[2 * j + 1] = from->spans[2 * i + 1];
+	}
+}
+
+/**
+ * @brief Doubles the table (or allocates the first one) and rehashes it.
+ * @return 0 on success, -1 if memory allocation fails (the set is unchanged).
+ */
+static int	grow_table(t_gnl_dedup *set)
+{
+	t_gnl_dedup	big;
+	size_t		i;
+
+	big = *set;
+	big.cap = set->cap * 2;
+	if (!big.cap)
+		big.cap = FIRST_CAP;
+	big.hashes = (uint64_t *)calloc(big.cap, sizeof(uint64_t));
+	big.spans = NULL;
+	if (set->exact)
+		big.spans = (size_t *)malloc(2 * big.cap * sizeof(size_t));
+	if (!big.hashes || (set->exact && !big.spans))
+		return (free(big.hashes), free(big.spans), -1);
+	i = 0;
+	while (i < set->cap)
+	{
+		if (set->hashes[i])
+			move_slot(&big, set, i);
+		i++;
+	}
+	free(set->hashes);
+	free(set->spans);
+	*set = big;
+	return (0);
+}
+
+/**
+ * @brief Adds a line to the set, in the slot find_slot returned.
+ * @return 0 on success, -1 if memory allocation fails (the set is unchanged).
+ */
+static int	insert(t_gnl_dedup *set, size_t slot, uint64_t h, const char *line,
+		size_t len)
+{
+	char	*bigger;
+	size_t	cap;
+
+	if (set->exact && set->arena_cap - set->arena_len < len)
+	{
+		cap = set->arena_cap * 2 + len;
+		bigger = (char *)malloc(cap * sizeof(char));
+		if (!bigger)
+			return (-1);
+		if (set->arena_len)
+			ft_memcpy(bigger, set->arena, set->arena_len);
+		free(set->arena);
+		set->arena = bigger;
+		set->arena_cap = cap;
+	}
+	set->hashes[slot] = h;
+	if (set->exact)
+	{
+		ft_memcpy(set->arena + set->arena_len, line, len);
+		set->spans[2 * slot] = set->arena_len;
+		set->spans[2 * slot + 1] = len;
+		set->arena_len += len;
+	}
+	set->count++;
+	return (0);
+}
+
+/**
+ * @brief Returns the next line of a file descriptor that was not returned
+ * before.
+ * @param fd The file descriptor to read from.
+ * @param set The lines seen so far, zeroed before the first call (set exact
+ * to compare lines in full, not only their hashes).
+ * @return
+ * - A null-terminated string containing the line read, newline included.
+ *
+ * - NULL on EOF, read error or memory allocation failure.
+ * @note Duplicates are dropped from the read buffer without being allocated.
+ * As with get_next_line, the reader is cleared when NULL is returned; the set
+ * is kept, to go on with another fd.
+ * @warning The returned string must be freed by the caller.
+ */
+char	*gnl_next_unique(int fd, t_gnl_dedup *set)
+{
+	t_gnl		*gnl;
+	ssize_t		len;
+	ssize_t		slot;
+	uint64_t	h;
+	const char	*line;
+
+	gnl = gnl_get(fd);
+	if (!gnl || !set || BUFFER_SIZE <= 0)
+		return (NULL);
+	while (1)
+	{
+		len = hash_line(gnl, fd, &h);
+		if (len <= 0 || ((set->count + 1) * 4 > set->cap * 3
+				&& grow_table(set) == -1))
+			break ;
+		line = gnl_store_data(&gnl->store);
+		slot = find_slot(set, h, line, len - (line[len - 1] == '\n'));
+		if (slot >= 0)
+		{
+			if (insert(set, slot, h, line, len - (line[len - 1] == '\n')))
+				break ;
+			return (gnl_take(gnl, len));
+		}
+		gnl_store_consume(&gnl->store, len);
+	}
+	gnl_clear(gnl);
+	return (NULL);
+}
+
+/**
+ * @brief Frees the lines seen by gnl_next_unique. The set can be used again,
+ * empty, with the same exact setting.
+ * @param set The set.
+ */
+void	gnl_dedup_free(t_gnl_dedup *set)
+{
+	if (!set)
+		return ;
+	free(set->hashes);
+	free(set->spans);
+	free(set->arena);
+	*set = (t_gnl_dedup){NULL, NULL, NULL, 0, 0, 0, 0, set->exact};
+}
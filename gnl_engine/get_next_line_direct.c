@@ -0,0 +1,169 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_direct.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 17:02:48 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 16:52:31 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#define _GNU_SOURCE
+#include "get_next_line.h"
+#include <errno.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * Direct I/O. With gnl_set_direct, reads of a regular file bypass the page
+ * cache: the store is mapped in GNL_DIRECT_SIZE (2 MiB) multiples, optionally
+ * backed by huge pages, and every read starts on a GNL_DIRECT_ALIGN boundary
+ * of both the file and the buffer, for a whole number of blocks. Only the
+ * contiguous buffer storage can keep that alignment.
+ * If the kernel still refuses a read (an unaligned offset left by an lseek, a
+ * file system without O_DIRECT), gnl_fill drops O_DIRECT and reads buffered.
+ */
+
+#ifndef MAP_HUGE_2MB
+# define MAP_HUGE_2MB 0
+#endif
+
+/**
+ * @brief Maps `size` bytes of anonymous memory aligned to GNL_DIRECT_SIZE.
+ * @param size The size, a multiple of GNL_DIRECT_SIZE.
+ * @param huge GNL_HUGE_NONE for normal pages, GNL_HUGE_THP to ask for
+ * transparent huge pages, GNL_HUGE_TLB to take reserved huge pages (falling
+ * back to GNL_HUGE_THP if none are reserved).
+ * @return The mapping, or NULL if it fails.
+ */
+char	*gnl_map(size_t size, int huge)
+{
+	char		*map;
+	uintptr_t	skip;
+
+	if (huge == GNL_HUGE_TLB)
+	{
+		map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE
+				| MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+		if (map != MAP_FAILED)
+			return (map);
+	}
+	map = mmap(NULL, size + GNL_DIRECT_SIZE, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (map == MAP_FAILED)
+		return (NULL);
+	skip = (GNL_DIRECT_SIZE - (uintptr_t)map % GNL_DIRECT_SIZE)
+		% GNL_DIRECT_SIZE;
+	if (skip)
+		munmap(map, skip);
+	munmap(map + skip + size, GNL_DIRECT_SIZE - skip);
+	map += skip;
+	if (huge != GNL_HUGE_NONE)
+		madvise(map, size, MADV_HUGEPAGE);
+	return (map);
+}
+
+void	gnl_unmap(char *map, size_t size)
+{
+	munmap(map, size);
+}
+
+/**
+ * @brief Drops O_DIRECT from a fd, so the read it refused can be retried
+ * buffered.
+ * @param fd The file descriptor.
+ * @return 1 if O_DIRECT was set and is now cleared, 0 otherwise.
+ */
+int	gnl_direct_off(int fd)
+{
+	int	flags;
+
+	flags = fcntl(fd, F_GETFL);
+	if (flags == -1 || !(flags & O_DIRECT))
+		return (0);
+	return (fcntl(fd, F_SETFL, flags & ~O_DIRECT) == 0);
+}
+
+#if GNL_STORAGE == GNL_STORAGE_BUF
+
+/**
+ * @brief Reads buffered up to the next aligned file offset, so that the
+ * direct reads that follow start on a block boundary. The reads go through
+ * the page cache policies like any other (see gnl_cache_step).
+ * @return 0 on success (EOF included), -1 on read error or memory allocation
+ * failure.
+ */
+static int	read_head(t_gnl *gnl, int fd)
+{
+	off_t	pos;
+	char	*tail;
+	size_t	room;
+	ssize_t	bytes_read;
+
+	pos = lseek(fd, 0, SEEK_CUR);
+	if (pos == -1)
+		return (-1);
+	while (pos % GNL_DIRECT_ALIGN)
+	{
+		room = GNL_DIRECT_ALIGN;
+		tail = gnl_store_reserve(&gnl->store, &room);
+		if (!tail)
+			return (-1);
+		bytes_read = read(fd, tail, GNL_DIRECT_ALIGN - pos % GNL_DIRECT_ALIGN);
+		if (bytes_read > 0)
+			gnl_store_commit(&gnl->store, bytes_read);
+		if (bytes_read >= 0 && gnl->cache.policy)
+			gnl_cache_step(gnl, fd, bytes_read);
+		if (bytes_read <= 0)
+			return (bytes_read);
+		pos += bytes_read;
+	}
+	return (0);
+}
+
+/**
+ * @brief Switches a file descriptor to direct I/O.
+ * @param fd A file descriptor open on a regular file or block device.
+ * @param huge How to back the read buffer, see gnl_map.
+ * @return 0 on success, -1 on error (errno is ENOTSUP for pipes, sockets and
+ * terminals). Lines already read are kept either way.
+ * @note The reader's state is kept: the pending bytes are moved into the new
+ * buffer and the file is read buffered up to the next block boundary first.
+ */
+int	gnl_set_direct(int fd, int huge)
+{
+	t_gnl		*gnl;
+	struct stat	st;
+	int			flags;
+
+	gnl = gnl_get(fd);
+	if (!gnl || fstat(fd, &st) == -1)
+		return (-1);
+	if (!S_ISREG(st.st_mode) && !S_ISBLK(st.st_mode))
+	{
+		errno = ENOTSUP;
+		return (-1);
+	}
+	if (gnl_store_align(&gnl->store, GNL_DIRECT_ALIGN, huge) == -1
+		|| read_head(gnl, fd) == -1)
+		return (-1);
+	flags = fcntl(fd, F_GETFL);
+	if (flags == -1 || fcntl(fd, F_SETFL, flags | O_DIRECT) == -1)
+		return (-1);
+	return (0);
+}
+
+#else
+
+int	gnl_set_direct(int fd, int huge)
+{
+	(void)fd;
+	(void)huge;
+	errno = ENOTSUP;
+	return (-1);
+}
+
+#endif
@@ -0,0 +1,302 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_follow.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 19:05:52 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 15:41:18 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <string.h>
+#include <time.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+
+/*
+ * Follow mode, like tail -F. At EOF the reader waits on inotify instead of
+ * returning, and the bytes read so far stay in the store: a partial last line
+ * is returned once its newline arrives. Two watches are kept in the reader
+ * from the first EOF until gnl_close or gnl_reset:
+ * - The file itself: written, truncated, moved or deleted.
+ * - Its directory: a file created or moved in under the same name (rotation).
+ * When the path names a new file, the old fd is first read to EOF, then
+ * reopened on the new file with dup2, so the caller's fd and reader stay the
+ * same. When the file shrinks below the read offset it was truncated: reading
+ * starts again at 0.
+ */
+
+#define FILE_EVENTS (IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF)
+
+/**
+ * @brief State of one gnl_follow call.
+ * - base: The file name inside the directory.
+ * - deadline: When to give up (CLOCK_MONOTONIC), unless timeout < 0.
+ */
+typedef struct s_follow
+{
+	t_gnl			*gnl;
+	int				fd;
+	const char		*path;
+	const char		*base;
+	int				timeout;
+	struct timespec	deadline;
+}	t_follow;
+
+/**
+ * @brief Starts watching the file and its directory.
+ * @return 0 on success, -1 on error.
+ */
+static int	watch(t_follow *f)
+{
+	t_watch	*w;
+	char	dir[PATH_MAX];
+	size_t	len;
+
+	w = &f->gnl->watch;
+	len = f->base - f->path;
+	if (len >= PATH_MAX)
+		return (errno = ENAMETOOLONG, -1);
+	ft_memcpy(dir, f->path, len);
+	dir[len] = '\0';
+	if (len == 0)
+		ft_memcpy(dir, ".", 2);
+	w->ino = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (w->ino == -1)
+		return (-1);
+	w->file = inotify_add_watch(w->ino, f->path, FILE_EVENTS);
+	w->dir = inotify_add_watch(w->ino, dir, IN_CREATE | IN_MOVED_TO);
+	if (w->dir == -1)
+		return (close(w->ino), -1);
+	w->on = 1;
+	return (0);
+}
+
+/**
+ * @brief Reads the pending inotify events.
+ * @return 1 if one concerns the followed file, 0 otherwise.
+ */
+static int	drain_events(t_follow *f)
+{
+	char					buf[4096]
+		__attribute__((aligned(__alignof__(struct inotify_event))));
+	struct inotify_event	*ev;
+	ssize_t					got;
+	ssize_t					i;
+	int						hit;
+
+	hit = 0;
+	got = read(f->gnl->watch.ino, buf, sizeof(buf));
+	while (got > 0)
+	{
+		i = 0;
+		while (i < got)
+		{
+			ev = (struct inotify_event *)(buf + i);
+			if (ev->wd == f->gnl->watch.file
+				|| (ev->len && !strcmp(ev->name, f->base)))
+				hit = 1;
+			i += sizeof(*ev) + ev->len;
+		}
+		got = read(f->gnl->watch.ino, buf, sizeof(buf));
+	}
+	return (hit);
+}
+
+/**
+ * @brief Waits until the followed file changes or the deadline passes.
+ * @return 1 on change, 0 on timeout (errno is ETIMEDOUT), -1 on error.
+ */
+static int	wait_change(t_follow *f)
+{
+	struct pollfd	pfd;
+	struct timespec	now;
+	long			left;
+
+	pfd = (struct pollfd){f->gnl->watch.ino, POLLIN, 0};
+	while (1)
+	{
+		left = -1;
+		if (f->timeout >= 0)
+		{
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			left = (f->deadline.tv_sec - now.tv_sec) * 1000
+				+ (f->deadline.tv_nsec - now.tv_nsec) / 1000000;
+			if (left < 0)
+				left = 0;
+		}
+		if (poll(&pfd, 1, left) == -1 && errno != EINTR)
+			return (-1);
+		if (drain_events(f))
+			return (1);
+		if (left == 0)
+			return (errno = ETIMEDOUT, 0);
+	}
+}
+
+/**
+ * @brief Tells whether the path now names another file than the fd.
+ * @note A path that names nothing (between the move and the creation of a
+ * rotation) is not a new file yet.
+ */
+static int	rotated(t_follow *f)
+{
+	struct stat	at_path;
+	struct stat	open_st;
+
+	if (fstat(f->fd, &open_st) == -1 || stat(f->path, &at_path) == -1)
+		return (0);
+	return (at_path.st_ino != open_st.st_ino
+		|| at_path.st_dev != open_st.st_dev);
+}
+
+/**
+ * @brief Reopens the fd on the file the path now names, and moves the file
+ * watch onto it.
+ * @return 0 on success, -1 if the new file cannot be opened.
+ */
+static int	switch_file(t_gnl *gnl, t_follow *f)
+{
+	int	fd;
+
+	fd = open(f->path, O_RDONLY);
+	if (fd == -1 || dup2(fd, f->fd) == -1)
+		return (close(fd), -1);
+	close(fd);
+	inotify_rm_watch(gnl->watch.ino, gnl->watch.file);
+	gnl->watch.file = inotify_add_watch(gnl->watch.ino, f->path, FILE_EVENTS);
+	gnl->cache = (t_cache){0};
+	gnl->known = 0;
+	return (0);
+}
+
+/**
+ * @brief Starts over from 0 if the file shrank below the read offset,
+ * dropping everything pending.
+ */
+static void	truncation(t_gnl *gnl, t_follow *f)
+{
+	struct stat	st;
+
+	if (fstat(f->fd, &st) == 0 && S_ISREG(st.st_mode)
+		&& st.st_size < lseek(f->fd, 0, SEEK_CUR))
+	{
+		lseek(f->fd, 0, SEEK_SET);
+		gnl_store_clear(&gnl->store);
+		gnl->cache = (t_cache){0};
+	}
+}
+
+/**
+ * @brief Handles EOF, reached with no complete line pending. The first time,
+ * starts watching and reads again, so bytes written before the watch was set
+ * are not missed. Then waits for a change, unless the path names a new file
+ * already: the old file has just read EOF, so it is left for the new one.
+ * @return 0 to read again, 1 to return the pending bytes as a line (the old
+ * file ended without a newline), -1 to give up (timeout or error).
+ * @note After a change that is a rotation, the old fd is read again until
+ * EOF, so what was written to it after the last read is not lost.
+ */
+static int	at_eof(t_gnl *gnl, t_follow *f)
+{
+	if (!gnl->watch.on)
+		return (watch(f));
+	if (rotated(f))
+	{
+		if (switch_file(gnl, f) == -1)
+			return (-1);
+		return (gnl_store_len(&gnl->store) != 0);
+	}
+	if (wait_change(f) != 1)
+		return (-1);
+	if (!rotated(f))
+		truncation(gnl, f);
+	return (0);
+}
+
+static void	set_deadline(t_follow *f)
+{
+	clock_gettime(CLOCK_MONOTONIC, &f->deadline);
+	f->deadline.tv_sec += f->timeout / 1000;
+	f->deadline.tv_nsec += f->timeout % 1000 * 1000000L;
+	if (f->deadline.tv_nsec >= 1000000000L)
+	{
+		f->deadline.tv_sec++;
+		f->deadline.tv_nsec -= 1000000000L;
+	}
+}
+
+/**
+ * @brief Reads until a line is complete, waiting at EOF.
+ * @return The length of the line, or -1 on timeout or error.
+ */
+static ssize_t	follow_len(t_follow *f)
+{
+	ssize_t	i_nl;
+	size_t	scanned;
+	ssize_t	got;
+	int		eof;
+
+	scanned = 0;
+	while (1)
+	{
+		i_nl = gnl_store_find(&f->gnl->store, scanned, '\n');
+		if (i_nl >= 0)
+			return (i_nl + 1);
+		scanned = gnl_store_len(&f->gnl->store);
+		got = gnl_fill(f->gnl, f->fd);
+		eof = 0;
+		if (got == 0)
+			eof = at_eof(f->gnl, f);
+		if (got == -1 || eof == -1)
+			return (-1);
+		if (eof == 1)
+			return (gnl_store_len(&f->gnl->store));
+		if (scanned > gnl_store_len(&f->gnl->store))
+			scanned = 0;
+	}
+}
+
+/**
+ * @brief Returns the next line of a file that is still being written,
+ * waiting for it if needed.
+ * @param fd The file descriptor, open on `path`.
+ * @param path The path to follow: if it is rotated, fd is reopened on the new
+ * file. Pass the same path on every call for a fd.
+ * @param timeout The most milliseconds to wait for a line, or -1 for no limit.
+ * @return
+ * - A null-terminated string containing the line read, newline included. The
+ * last line of a rotated file is returned as it is, without a newline.
+ *
+ * - NULL on timeout (errno is ETIMEDOUT), read error or memory allocation
+ * failure, or with errno EINVAL for a source (see gnl_open_source): it has no
+ * file to follow.
+ * @note The reader is never cleared: after NULL, the next call resumes with the
+ * same pending bytes, at the same file offset. The inotify watches stay with
+ * the reader until gnl_close or gnl_reset.
+ * @warning The returned string must be freed by the caller.
+ */
+char	*gnl_follow(int fd, const char *path, int timeout)
+{
+	t_follow	f;
+	ssize_t		len;
+
+	f = (t_follow){gnl_get(fd), fd, path, path, timeout, {0, 0}};
+	if (f.gnl && f.gnl->source)
+		return (errno = EINVAL, NULL);
+	if (!f.gnl || !path || BUFFER_SIZE <= 0)
+		return (NULL);
+	if (ft_memrchr(path, '/', ft_strlen(path)))
+		f.base = (char *)ft_memrchr(path, '/', ft_strlen(path)) + 1;
+	set_deadline(&f);
+	len = follow_len(&f);
+	if (len <= 0)
+		return (NULL);
+	return (gnl_take(f.gnl, len));
+}
@@ -0,0 +1,58 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_foreach.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 12:14:03 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/20 00:41:27 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+
+/**
+ * @brief Visits every line of a file descriptor without allocating them.
+ * @param fd The file descriptor to read from.
+ * @param callback Called as `callback(line, len, userdata)` for each line.
+ * `line` points into the reader's store, is not null-terminated and includes
+ * the newline, except for a last line that does not end with one. It is only
+ * valid during the call. Returning nonzero stops the visit.
+ * @param userdata Passed untouched to the callback.
+ * @return
+ * - 0 once every line up to EOF has been visited.
+ *
+ * - The nonzero value returned by the callback if it stopped the visit.
+ *
+ * - -1 on invalid arguments, read error or memory allocation failure.
+ * @note Shares the fd's reader with get_next_line: lines it already buffered
+ * are visited first, and if the callback stops the visit the following lines
+ * stay buffered for the next call. With GNL_STORAGE_BUF a line is only moved
+ * when it straddles the end of the buffer; the other storages make a line
+ * contiguous only when it spans two chunks or wraps around the ring.
+ */
+int	gnl_for_each_line(int fd, t_gnl_line_fn callback, void *userdata)
+{
+	t_gnl	*gnl;
+	ssize_t	len;
+	char	*line;
+	int		status;
+
+	gnl = gnl_get(fd);
+	if (!gnl || BUFFER_SIZE <= 0 || !callback)
+		return (-1);
+	status = 0;
+	while (status == 0)
+	{
+		len = gnl_line_len(gnl, fd);
+		if (len <= 0)
+			return (gnl_clear(gnl), (int)len);
+		line = gnl_store_data(&gnl->store);
+		if (!line)
+			return (gnl_clear(gnl), -1);
+		status = callback(line, len, userdata);
+		gnl_store_consume(&gnl->store, len);
+	}
+	return (status);
+}
@@ -0,0 +1,176 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_match.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 16:38:15 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/20 00:41:27 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+
+/**
+ * @brief What a line must contain to be returned.
+ * - needle: The bytes searched for in the store. For a prefix, a newline
+ *   followed by the prefix, so that only line starts match.
+ * - len: The length of needle.
+ * - prefix: Whether needle is a newline plus a prefix.
+ */
+typedef struct s_match
+{
+	const char	*needle;
+	size_t		len;
+	int			prefix;
+}	t_match;
+
+/**
+ * @brief Finds the first line of the pending bytes that matches.
+ * @param data The pending bytes. They always start at the start of a line.
+ * @param len The number of pending bytes.
+ * @param from Where the search for the needle starts: positions before it
+ * were ruled out by an earlier search.
+ * @param m The match to look for.
+ * @return The offset of the start of the matching line, -1 if no line
+ * matches, or -2 if the first line is too short yet to tell.
+ */
+static ssize_t	find_line(const char *data, size_t len, size_t from,
+		const t_match *m)
+{
+	char	*hit;
+	char	*nl;
+	size_t	n;
+
+	if (m->prefix)
+	{
+		n = m->len - 1;
+		if (n > len)
+			n = len;
+		if (!ft_memcmp(data, m->needle + 1, n))
+			return (-2 * (n < m->len - 1));
+	}
+	hit = ft_memmem(data + from, len - from, m->needle, m->len);
+	if (!hit)
+		return (-1);
+	if (m->prefix)
+		return (hit - data + 1);
+	nl = ft_memrchr(data, '\n', hit - data);
+	if (!nl)
+		return (0);
+	return (nl - data + 1);
+}
+
+/**
+ * @brief Drops the complete lines of the pending bytes after a miss.
+ * @return Where the next search for the needle can start: the only positions
+ * left to check are those where the needle would not fit before.
+ */
+static size_t	skip_lines(t_store *st, const char *data, const t_match *m)
+{
+	char	*nl;
+	size_t	len;
+
+	len = gnl_store_len(st);
+	nl = ft_memrchr(data, '\n', len);
+	if (nl)
+	{
+		gnl_store_consume(st, nl - data + 1);
+		len = gnl_store_len(st);
+	}
+	if (len < m->len)
+		return (0);
+	return (len - m->len + 1);
+}
+
+/**
+ * @brief Skips lines until one matches, then returns it.
+ * @return The matching line, or NULL at EOF, on error, or if memory
+ * allocation fails. The reader is cleared in those cases.
+ */
+static char	*next_match(t_gnl *gnl, int fd, const t_match *m)
+{
+	ssize_t	start;
+	ssize_t	len;
+	size_t	from;
+	char	*data;
+
+	from = 0;
+	while (1)
+	{
+		start = -1;
+		data = gnl_store_data(&gnl->store);
+		if (data)
+			start = find_line(data, gnl_store_len(&gnl->store), from, m);
+		if (start >= 0)
+			break ;
+		from = 0;
+		if (start == -1 && data)
+			from = skip_lines(&gnl->store, data, m);
+		if (gnl_fill(gnl, fd) <= 0)
+			return (gnl_clear(gnl), NULL);
+	}
+	gnl_store_consume(&gnl->store, start);
+	len = gnl_line_len(gnl, fd);
+	data = NULL;
+	if (len > 0)
+		data = gnl_take(gnl, len);
+	if (!data)
+		gnl_clear(gnl);
+	return (data);
+}
+
+/**
+ * @brief Returns the next line that contains a string, skipping the others.
+ * @param fd The file descriptor to read from.
+ * @param needle The string to look for. It should not contain a newline.
+ * @return The next matching line, newline included, or NULL at EOF or on
+ * error.
+ * @note The needle is searched in the whole read buffer at once with
+ * ft_memmem, not line by line. After a miss every complete line is dropped at
+ * once, so lines that do not match are never allocated nor copied.
+ * @warning The returned string must be freed by the caller.
+ */
+char	*gnl_next_matching(int fd, const char *needle)
+{
+	t_gnl	*gnl;
+	t_match	m;
+
+	gnl = gnl_get(fd);
+	if (!gnl || !needle || BUFFER_SIZE <= 0)
+		return (NULL);
+	m = (t_match){needle, ft_strlen(needle), 0};
+	return (next_match(gnl, fd, &m));
+}
+
+/**
+ * @brief Returns the next line that starts with a prefix, skipping the others.
+ * @param fd The file descriptor to read from.
+ * @param prefix The string the line must start with.
+ * @return The next matching line, newline included, or NULL at EOF or on
+ * error.
+ * @note Searches for a newline followed by the prefix, so occurrences of the
+ * prefix in the middle of lines are not even candidates.
+ * @warning The returned string must be freed by the caller.
+ */
+char	*gnl_next_prefixed(int fd, const char *prefix)
+{
+	t_gnl	*gnl;
+	t_match	m;
+	char	*needle;
+	char	*line;
+
+	gnl = gnl_get(fd);
+	if (!gnl || !prefix || BUFFER_SIZE <= 0)
+		return (NULL);
+	m.len = ft_strlen(prefix) + 1;
+	needle = (char *)malloc(m.len * sizeof(char));
+	if (!needle)
+		return (NULL);
+	needle[0] = '\n';
+	ft_memcpy(needle + 1, prefix, m.len - 1);
+	m = (t_match){needle, m.len, 1};
+	line = next_match(gnl, fd, &m);
+	return (free(needle), line);
+}
@@ -0,0 +1,92 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_peek.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/21 01:06:18 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 17:08:56 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+#include <errno.h>
+
+/**
+ * @brief Pushes back the last bytes of the line the previous call on fd
+ * handed out as a view (gnl_next_view or gnl_next_record), so that the next
+ * call returns them again.
+ * @param fd The file descriptor.
+ * @param n The number of bytes to push back, at most the length of that line:
+ * its length pushes the whole line back.
+ * @return 0 on success, -1 with errno EINVAL if n is larger than what the
+ * previous call handed out, or if fd is out of range.
+ * @note Nothing is copied: a view is still in the store until the next call
+ * consumes it, and this only consumes less of it. It must come right after the
+ * call that returned the line, with no other call on fd in between, and only
+ * that one line can be pushed back. get_next_line consumes the line it copies,
+ * so nothing of it can be pushed back: peek with gnl_peek_line instead.
+ */
+int	gnl_unread(int fd, size_t n)
+{
+	t_gnl	*gnl;
+
+	gnl = gnl_slot(fd);
+	if (!gnl || n > gnl->held)
+		return (errno = EINVAL, -1);
+	gnl->held -= n;
+	return (0);
+}
+
+/**
+ * @brief Returns the next line without consuming it: the next call on fd
+ * (get_next_line, gnl_next_view...) returns it again.
+ * @param fd The file descriptor (or source, see gnl_open_source).
+ * @param len Set to the length of the line, newline included.
+ * @return A pointer to the line, NOT null-terminated, valid until the next
+ * call on fd; NULL with errno 0 at EOF, NULL with errno set on error.
+ * @note A lookahead costs no allocation or copy: the line is a view into the
+ * reader's buffer, see gnl_next_view.
+ */
+const char	*gnl_peek_line(int fd, size_t *len)
+{
+	const char	*line;
+
+	line = gnl_next_view(fd, len);
+	if (line)
+		gnl_unread(fd, *len);
+	return (line);
+}
+
+/* ************************************************************************** */
+/* ************************* UNCOMMENT FOR TESTING  ************************* */
+/* ************************************************************************** */
+
+// Groups each log entry with its continuation lines (lines starting with a
+// space or a tab), peeking one line ahead to find where the entry ends.
+// int	main(int argc, char **argv)
+// {
+// 	int			fd;
+// 	char		*line;
+// 	const char	*next;
+// 	size_t		len;
+
+// 	fd = open(argv[argc - 1], O_RDONLY);
+// 	line = get_next_line(fd);
+// 	while (line)
+// 	{
+// 		printf("%s", line);
+// 		free(line);
+// 		next = gnl_peek_line(fd, &len);
+// 		while (next && (next[0] == ' ' || next[0] == '\t'))
+// 		{
+// 			printf("%.*s", (int)len, next);
+// 			gnl_next_view(fd, &len);
+// 			next = gnl_peek_line(fd, &len);
+// 		}
+// 		printf("----\n");
+// 		line = get_next_line(fd);
+// 	}
+// 	return (close(fd), 0);
+// }
@@ -0,0 +1,408 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_pipeline.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 23:31:17 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 15:41:18 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+
+/*
+ * Ordered parallel pipeline, for streams that cannot be split by offset
+ * (pipes, sockets, terminals):
+ * - A reader thread reads straight into block buffers and cuts them after
+ *   their last newline, once GNL_PIPE_BLOCK bytes are in or nothing more is
+ *   ready to read. The cut-off partial line starts the next block.
+ * - Worker threads take the blocks in input order and transform them.
+ * - The calling thread emits the results strictly in input order.
+ * Block n lives in slot n % window until it is emitted, so the reader stops
+ * when the oldest result is still window blocks behind: memory is bounded by
+ * the window, whatever the speed of each stage. One mutex and one condition
+ * guard the counters; a block is handed over at most 3 times, so they are
+ * taken a few times per megabyte. The reader waits for input in poll, along
+ * with a wake pipe that the calling thread closes when it is done, so a
+ * reader stuck on an idle stream stops after a failure.
+ */
+
+/**
+ * @brief A block in flight: its lines and, once transformed, the result.
+ */
+typedef struct s_slot
+{
+	char	*in;
+	size_t	in_len;
+	char	*out;
+	ssize_t	out_len;
+	int		done;
+}	t_slot;
+
+/**
+ * @brief The block the reader is filling.
+ */
+typedef struct s_block
+{
+	char	*buf;
+	size_t	len;
+	size_t	cap;
+}	t_block;
+
+/**
+ * @brief Shared state. Blocks are numbered in input order:
+ * - produced: Blocks cut by the reader.
+ * - taken: Blocks handed to a worker.
+ * - emitted: Results emitted.
+ * - eof: The reader is done. failed: Something failed, everyone stops.
+ * - error: The errno of the failure, 0 for a transform or emit failure.
+ * - wake: The wake pipe, closed on the writing side once collecting ends.
+ * - first: The reader's first block, holding the bytes the fd's reader had
+ *   already buffered.
+ */
+typedef struct s_pipeline
+{
+	const t_gnl_pipe	*cfg;
+	int					fd;
+	size_t				window;
+	t_slot				*slots;
+	size_t				produced;
+	size_t				taken;
+	size_t				emitted;
+	int					eof;
+	int					failed;
+	int					error;
+	pthread_mutex_t		lock;
+	pthread_cond_t		cond;
+	int					wake[2];
+	t_block				first;
+}	t_pipeline;
+
+/**
+ * @brief Marks the pipeline as failed and wakes everybody.
+ * @param error The errno to report, or 0 for a transform or emit failure.
+ */
+static void	fail(t_pipeline *p, int error)
+{
+	pthread_mutex_lock(&p->lock);
+	if (!p->failed)
+		p->error = error;
+	p->failed = 1;
+	pthread_cond_broadcast(&p->cond);
+	pthread_mutex_unlock(&p->lock);
+}
+
+/**
+ * @brief Makes room in the block for another read: doubles it when full.
+ * @return 0 on success, -1 if memory allocation fails.
+ */
+static int	grow_block(t_block *b)
+{
+	char	*bigger;
+
+	if (b->len < b->cap)
+		return (0);
+	bigger = (char *)malloc(b->cap * 2 * sizeof(char));
+	if (!bigger)
+		return (-1);
+	ft_memcpy(bigger, b->buf, b->len);
+	free(b->buf);
+	b->buf = bigger;
+	b->cap *= 2;
+	return (0);
+}
+
+/**
+ * @brief Reads until the block holds a cut point.
+ * @return The length of the block to hand over (up to and including its last
+ * newline, or everything at EOF), 0 at EOF with nothing left, -1 on error
+ * or once the wake pipe is closed.
+ */
+static ssize_t	fill_block(t_pipeline *p, t_block *b)
+{
+	ssize_t			got;
+	char			*nl;
+	struct pollfd	pfd[2];
+
+	pfd[0] = (struct pollfd){p->fd, POLLIN, 0};
+	pfd[1] = (struct pollfd){p->wake[0], POLLIN, 0};
+	got = 1;
+	while (got)
+	{
+		nl = ft_memrchr(b->buf, '\n', b->len);
+		if (nl && (b->len >= GNL_PIPE_BLOCK || poll(pfd, 1, 0) == 0))
+			return (nl - b->buf + 1);
+		if (grow_block(b) == -1)
+			return (-1);
+		got = poll(pfd, 2, -1);
+		if (got == -1 && errno != EINTR)
+			return (-1);
+		if (got > 0 && pfd[1].revents)
+			return (errno = ECANCELED, -1);
+		if (got > 0)
+			got = read(p->fd, b->buf + b->len, b->cap - b->len);
+		if (got == -1 && errno != EINTR)
+			return (-1);
+		if (got > 0)
+			b->len += got;
+	}
+	return (b->len);
+}
+
+/**
+ * @brief Hands the first `cut` bytes of the block over to the workers, and
+ * starts the next block with the rest.
+ * @return 0 on success, -1 if the pipeline failed, or if memory allocation
+ * fails: the pipeline is then failed with ENOMEM.
+ */
+static int	push_block(t_pipeline *p, t_block *b, size_t cut)
+{
+	t_block	next;
+	t_slot	*slot;
+	int		failed;
+
+	next.cap = GNL_PIPE_BLOCK;
+	while (next.cap < (b->len - cut) * 2)
+		next.cap *= 2;
+	next.buf = (char *)malloc(next.cap * sizeof(char));
+	if (!next.buf)
+		return (fail(p, ENOMEM), -1);
+	next.len = b->len - cut;
+	ft_memcpy(next.buf, b->buf + cut, next.len);
+	pthread_mutex_lock(&p->lock);
+	while (!p->failed && p->produced - p->emitted >= p->window)
+		pthread_cond_wait(&p->cond, &p->lock);
+	failed = p->failed;
+	if (!failed)
+	{
+		slot = &p->slots[p->produced++ % p->window];
+		*slot = (t_slot){b->buf, cut, NULL, 0, 0};
+		pthread_cond_broadcast(&p->cond);
+	}
+	pthread_mutex_unlock(&p->lock);
+	if (failed)
+		free(b->buf);
+	*b = next;
+	return (-failed);
+}
+
+/**
+ * @brief The reader thread: cuts the input into blocks until EOF.
+ */
+static void	*reader_main(void *arg)
+{
+	t_pipeline	*p;
+	t_block		b;
+	ssize_t		cut;
+
+	p = (t_pipeline *)arg;
+	b = p->first;
+	cut = fill_block(p, &b);
+	while (cut > 0 && push_block(p, &b, cut) == 0)
+		cut = fill_block(p, &b);
+	if (cut == -1)
+		fail(p, errno);
+	pthread_mutex_lock(&p->lock);
+	p->eof = 1;
+	pthread_cond_broadcast(&p->cond);
+	pthread_mutex_unlock(&p->lock);
+	free(b.buf);
+	return (NULL);
+}
+
+/**
+ * @brief A worker thread: transforms blocks, oldest first, until the reader
+ * is done and every block was taken.
+ */
+static void	*worker_main(void *arg)
+{
+	t_pipeline	*p;
+	t_slot		*slot;
+
+	p = (t_pipeline *)arg;
+	pthread_mutex_lock(&p->lock);
+	while (1)
+	{
+		while (!p->failed && p->taken == p->produced && !p->eof)
+			pthread_cond_wait(&p->cond, &p->lock);
+		if (p->failed || p->taken == p->produced)
+			break ;
+		slot = &p->slots[p->taken++ % p->window];
+		pthread_mutex_unlock(&p->lock);
+		slot->out_len = p->cfg->transform(slot->in, slot->in_len, &slot->out,
+				p->cfg->userdata);
+		pthread_mutex_lock(&p->lock);
+		slot->done = 1;
+		p->failed |= (slot->out_len < 0);
+		pthread_cond_broadcast(&p->cond);
+	}
+	pthread_mutex_unlock(&p->lock);
+	return (NULL);
+}
+
+/**
+ * @brief The collector, run by the calling thread: emits the results in
+ * input order and frees their blocks.
+ * @return 1 if the pipeline failed, 0 once every block was emitted.
+ */
+static int	collect(t_pipeline *p)
+{
+	t_slot	*slot;
+	int		stop;
+
+	pthread_mutex_lock(&p->lock);
+	while (1)
+	{
+		slot = &p->slots[p->emitted % p->window];
+		while (!p->failed && !(p->emitted < p->produced && slot->done)
+			&& !(p->eof && p->emitted == p->produced))
+			pthread_cond_wait(&p->cond, &p->lock);
+		if (p->failed || p->emitted == p->produced)
+			break ;
+		pthread_mutex_unlock(&p->lock);
+		stop = p->cfg->emit(slot->out, slot->out_len, p->cfg->userdata);
+		free(slot->in);
+		free(slot->out);
+		pthread_mutex_lock(&p->lock);
+		*slot = (t_slot){NULL, 0, NULL, 0, 0};
+		p->emitted++;
+		p->failed |= (stop != 0);
+		pthread_cond_broadcast(&p->cond);
+	}
+	stop = p->failed;
+	pthread_mutex_unlock(&p->lock);
+	return (stop);
+}
+
+/**
+ * @brief Sets up the shared state: the slots, and the first block, which
+ * takes over the bytes the fd's reader had already buffered.
+ * @return 0 on success, -1 if the wake pipe cannot be created or memory
+ * allocation fails.
+ */
+static int	setup(t_pipeline *p, int fd, t_gnl_pipe *conf)
+{
+	t_gnl	*gnl;
+	size_t	pending;
+	long	cpus;
+
+	cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	if (!conf->workers)
+		conf->workers = cpus * (cpus > 0) + (cpus <= 0);
+	if (!conf->window)
+		conf->window = 2 * conf->workers;
+	*p = (t_pipeline){conf, fd, conf->window, NULL, 0, 0, 0, 0, 0, 0,
+		PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, {-1, -1},
+		{NULL, 0, 0}};
+	if (pipe(p->wake) == -1)
+		return (-1);
+	gnl = gnl_get(fd);
+	pending = 0;
+	if (gnl)
+		pending = gnl_store_len(&gnl->store);
+	p->first.cap = GNL_PIPE_BLOCK;
+	while (p->first.cap < pending * 2)
+		p->first.cap *= 2;
+	p->first.buf = (char *)malloc(p->first.cap * sizeof(char));
+	p->slots = (t_slot *)calloc(p->window, sizeof(t_slot));
+	if (!p->first.buf || !p->slots)
+		return (free(p->first.buf), free(p->slots), close(p->wake[0]),
+			close(p->wake[1]), errno = ENOMEM, -1);
+	p->first.len = pending;
+	if (gnl && pending)
+		gnl_store_copy(&gnl->store, p->first.buf, pending);
+	if (gnl)
+		gnl_store_clear(&gnl->store);
+	return (0);
+}
+
+/**
+ * @brief Frees the blocks still in flight after a failure, the slots and the
+ * wake pipe.
+ */
+static void	cleanup(t_pipeline *p)
+{
+	while (p->emitted < p->produced)
+	{
+		free(p->slots[p->emitted % p->window].in);
+		free(p->slots[p->emitted++ % p->window].out);
+	}
+	free(p->slots);
+	close(p->wake[0]);
+	if (p->wake[1] != -1)
+		close(p->wake[1]);
+	pthread_mutex_destroy(&p->lock);
+	pthread_cond_destroy(&p->cond);
+}
+
+/**
+ * @brief Starts the reader and the workers.
+ * @return The number of workers started; -1 if the reader could not be.
+ */
+static ssize_t	start_threads(t_pipeline *p, pthread_t *threads)
+{
+	size_t	n;
+
+	if (pthread_create(&threads[0], NULL, reader_main, p) != 0)
+		return (-1);
+	n = 0;
+	while (n < p->cfg->workers
+		&& pthread_create(&threads[n + 1], NULL, worker_main, p) == 0)
+		n++;
+	if (!n)
+		fail(p, EAGAIN);
+	return (n);
+}
+
+/**
+ * @brief Transforms the lines of a stream on several threads and emits the
+ * results in input order.
+ * @param fd The stream: any fd, typically a pipe or socket that cannot be
+ * split by offset, but not a source (see gnl_open_source): it is read by the
+ * kernel. Bytes already buffered by its reader are read first.
+ * @param cfg The transform, the emitter and the sizes, see t_gnl_pipe.
+ * @return 0 once every block was emitted, -1 on read error, memory
+ * allocation or thread creation failure (errno is set), or if a transform or
+ * the emitter failed.
+ * @note Each block holds whole lines, except the last one if the stream does
+ * not end with a newline. Blocks still in flight after a failure are freed
+ * without being emitted.
+ */
+int	gnl_pipeline(int fd, const t_gnl_pipe *cfg)
+{
+	t_pipeline	p;
+	t_gnl_pipe	conf;
+	pthread_t	*threads;
+	ssize_t		n;
+	int			failed;
+
+	if (fd < 0 || !cfg || !cfg->transform || !cfg->emit
+		|| (gnl_slot(fd) && gnl_slot(fd)->source))
+		return (errno = EINVAL, -1);
+	conf = *cfg;
+	if (setup(&p, fd, &conf) == -1)
+		return (-1);
+	threads = (pthread_t *)malloc((conf.workers + 1) * sizeof(pthread_t));
+	n = -1;
+	if (threads)
+		n = start_threads(&p, threads);
+	if (n == -1)
+		return (free(threads), free(p.first.buf), cleanup(&p),
+			errno = EAGAIN, -1);
+	failed = collect(&p);
+	close(p.wake[1]);
+	p.wake[1] = -1;
+	pthread_join(threads[0], NULL);
+	while (n > 0)
+		pthread_join(threads[n--], NULL);
+	free(threads);
+	cleanup(&p);
+	if (failed && p.error)
+		errno = p.error;
+	return (-failed);
+}
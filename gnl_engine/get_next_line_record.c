@@ -0,0 +1,226 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_record.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:12:37 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 11:26:48 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+
+/*
+ * CSV/TSV records. A record is parsed straight in the reader's store: fields
+ * are (offset, length) spans into it, so nothing is copied or allocated per
+ * field. A newline inside a quoted field does not end the record; if the
+ * store ends inside a record, more is read and parsing resumes where it
+ * stopped, in the field it stopped in, so each byte is scanned once.
+ * Quoted fields span the text between the quotes, with any doubled quote
+ * ("") left as is: `quoted` tells the caller to unescape if it needs to.
+ */
+
+/**
+ * @brief The bytes a record is parsed from, and where parsing stopped.
+ * - set: The delimiter, a newline and a quote, the bytes ft_memchr3 stops at.
+ * - eof: Whether EOF was reached, so that nothing more will come.
+ * - pos: The offset the scan of the last field resumes from.
+ * - in_quotes: Whether pos is inside the quotes of the last field.
+ */
+typedef struct s_parse
+{
+	const char	*data;
+	size_t		len;
+	char		set[3];
+	int			eof;
+	size_t		pos;
+	int			in_quotes;
+}	t_parse;
+
+/**
+ * @brief Appends an empty field to the record, growing its array if needed.
+ * @return The new field, or NULL if memory allocation fails.
+ */
+static t_gnl_field	*add_field(t_gnl_record *rec, size_t off)
+{
+	t_gnl_field	*bigger;
+	size_t		cap;
+
+	if (rec->count == rec->cap)
+	{
+		cap = rec->cap * 2 + 8;
+		bigger = (t_gnl_field *)malloc(cap * sizeof(t_gnl_field));
+		if (!bigger)
+			return (NULL);
+		if (rec->count)
+			ft_memcpy(bigger, rec->fields, rec->count * sizeof(t_gnl_field));
+		free(rec->fields);
+		rec->fields = bigger;
+		rec->cap = cap;
+	}
+	rec->fields[rec->count] = (t_gnl_field){off, 0, 0};
+	return (&rec->fields[rec->count++]);
+}
+
+/**
+ * @brief Ends a field at `stop` (delimiter, newline, or end of the bytes at
+ * EOF); a quoted field already has its span.
+ * @return The offset of stop.
+ */
+static ssize_t	end_field(const t_parse *p, t_gnl_field *f, const char *stop)
+{
+	if (!f->quoted)
+		f->len = stop - (p->data + f->off);
+	return (stop - p->data);
+}
+
+/**
+ * @brief Handles a quote of the last field, at p->pos - 1: it opens the field
+ * if it starts it, closes it or is doubled if inside the quotes, and is a
+ * plain byte anywhere else.
+ * @return 0 to scan on, or -1 if more bytes are needed to tell.
+ */
+static int	quote(t_parse *p, t_gnl_field *f)
+{
+	if (!p->in_quotes)
+	{
+		if (p->pos - 1 == f->off && !f->quoted)
+		{
+			*f = (t_gnl_field){p->pos, 0, 1};
+			p->in_quotes = 1;
+		}
+		return (0);
+	}
+	if (p->pos == p->len && !p->eof)
+		return (p->pos--, -1);
+	if (p->pos < p->len && p->data[p->pos] == '"')
+		return (p->pos++, 0);
+	f->len = p->pos - 1 - f->off;
+	p->in_quotes = 0;
+	return (0);
+}
+
+/**
+ * @brief Scans the last field of the record from p->pos and fills its span.
+ * @return The offset of the byte ending the field (delimiter or newline), the
+ * end of the bytes if the field runs to EOF, or -1 if more bytes are needed:
+ * p->pos and p->in_quotes then tell where to resume.
+ */
+static ssize_t	parse_field(t_parse *p, t_gnl_field *f)
+{
+	const char	*hit;
+
+	while (1)
+	{
+		if (p->in_quotes)
+			hit = ft_memchr(p->data + p->pos, '"', p->len - p->pos);
+		else
+			hit = ft_memchr3(p->data + p->pos, p->len - p->pos, p->set);
+		if (!hit && !p->eof)
+			return (p->pos = p->len, -1);
+		if (!hit && p->in_quotes)
+			f->len = p->len - f->off;
+		if (!hit)
+			return (end_field(p, f, p->data + p->len));
+		p->pos = hit - p->data + 1;
+		if (*hit != '"')
+			return (end_field(p, f, hit));
+		if (quote(p, f) == -1)
+			return (-1);
+	}
+}
+
+/**
+ * @brief Splits the record at the start of the pending bytes into fields,
+ * resuming in its last field if an earlier call ran out of bytes.
+ * @param p The pending bytes.
+ * @param rec The record to fill, empty on the first call.
+ * @return The length of the record, newline included, 0 if more bytes are
+ * needed, or -1 if memory allocation fails.
+ */
+static ssize_t	parse_record(t_parse *p, t_gnl_record *rec)
+{
+	t_gnl_field	*field;
+	ssize_t		end;
+
+	if (!rec->count && !add_field(rec, 0))
+		return (-1);
+	while (1)
+	{
+		field = &rec->fields[rec->count - 1];
+		end = parse_field(p, field);
+		if (end < 0)
+			return (0);
+		if ((size_t)end == p->len)
+			return (p->len);
+		if (p->data[end] != p->set[0])
+			break ;
+		if (!add_field(rec, end + 1))
+			return (-1);
+	}
+	if (!field->quoted && field->len && p->data[end - 1] == '\r')
+		field->len--;
+	return (end + 1);
+}
+
+/**
+ * @brief Reads the next CSV/TSV record and splits it into fields, in place.
+ * @param fd The file descriptor to read from.
+ * @param delim The field delimiter, e.g. ',' or '\t'.
+ * @param rec The record to fill. Zero it before the first call and free it
+ * with gnl_record_free. Its field array is reused from call to call and only
+ * grows when a record has more fields than any before.
+ * @return 1 if a record was read, 0 at EOF, -1 on error.
+ * @note `rec->data` and the field spans point into the reader's store and
+ * stay valid until the next call on this fd. A record's trailing "\r" is not
+ * part of its last field.
+ */
+int	gnl_next_record(int fd, char delim, t_gnl_record *rec)
+{
+	t_gnl	*gnl;
+	t_parse	p;
+	ssize_t	len;
+	ssize_t	got;
+
+	gnl = gnl_get(fd);
+	if (!gnl || !rec || delim == '"' || delim == '\n' || BUFFER_SIZE <= 0)
+		return (-1);
+	p = (t_parse){NULL, 0, {delim, '\n', '"'}, 0, 0, 0};
+	rec->count = 0;
+	len = 0;
+	got = 0;
+	while (len == 0)
+	{
+		p.len = gnl_store_len(&gnl->store);
+		p.data = gnl_store_data(&gnl->store);
+		if (p.len && !p.data)
+			break ;
+		if (p.len)
+			len = parse_record(&p, rec);
+		got = 0;
+		if (len == 0 && !p.eof)
+			got = gnl_fill(gnl, fd);
+		if (got == -1 || (len == 0 && p.eof))
+			break ;
+		p.eof = (got == 0);
+	}
+	if (len <= 0)
+		return (gnl_clear(gnl), -(p.len || got == -1));
+	*rec = (t_gnl_record){p.data, len, rec->fields, rec->count, rec->cap};
+	gnl->held = len;
+	return (1);
+}
+
+/**
+ * @brief Frees the field array of a record and zeroes it.
+ * @param rec The record.
+ */
+void	gnl_record_free(t_gnl_record *rec)
+{
+	if (!rec)
+		return ;
+	free(rec->fields);
+	*rec = (t_gnl_record){NULL, 0, NULL, 0, 0};
+}
@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_reuse.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 01:05:48 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 17:36:42 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+#include <sys/stat.h>
+
+/*
+ * Fd reuse. A reader is keyed on the fd number only: if a fd is closed
+ * mid-file and the number is reused for another file, the reader still holds
+ * the old file's remainder. gnl_close and gnl_reset drop the reader when the
+ * caller closes a fd, at no cost. With GNL_CHECK_REUSE, the engine also
+ * notices by itself: the identity of the file (st_dev, st_ino) is taken by the
+ * first read into an empty reader, and checked again, by the next call, only
+ * when reuse is suspected:
+ * - The last read was short or hit EOF: the fd may have been closed there, and
+ *   a pipe or socket closed mid-stream ends this way.
+ * - The reuse generation moved: a fd was closed or reset since the last check,
+ *   so fd numbers are being recycled.
+ * Other calls cost no syscall. Calls on an empty reader check nothing: there
+ * is nothing stale to return, and the next read takes the identity again. A
+ * regular file closed with close() between two full reads is only noticed
+ * after its next short read: close such fds with gnl_close.
+ */
+
+/**
+ * @brief Returns the reuse generation, after moving it if bump is set. Only
+ * GNL_CHECK_REUSE builds move it: the others never read it.
+ */
+static unsigned int	generation(int bump)
+{
+	static unsigned int	gen;
+
+	if (bump)
+		gen++;
+	return (gen);
+}
+
+/**
+ * @brief Drops everything a reader holds: its bytes, its view, its page cache
+ * policies, its gnl_follow watches, the identity of its file and its source
+ * (which is closed).
+ */
+static void	drop(t_gnl *gnl)
+{
+	if (gnl->source && gnl->source->close)
+		gnl->source->close(gnl->ctx);
+	if (gnl->watch.on)
+		close(gnl->watch.ino);
+	gnl_store_clear(&gnl->store);
+	*gnl = (t_gnl){0};
+	if (GNL_CHECK_REUSE)
+		generation(1);
+}
+
+#if GNL_CHECK_REUSE
+
+/**
+ * @brief Records the identity of the file a reader reads from, unless it is
+ * known already.
+ * @param gnl The reader.
+ * @param fd Its file descriptor.
+ */
+void	gnl_note_fd(t_gnl *gnl, int fd)
+{
+	struct stat	st;
+
+	if (gnl->known || fstat(fd, &st) == -1)
+		return ;
+	gnl->dev = st.st_dev;
+	gnl->ino = st.st_ino;
+	gnl->known = 1;
+	gnl->gen = generation(0);
+}
+
+/**
+ * @brief Drops the bytes of a reader if its fd no longer refers to the file
+ * they were read from.
+ * @param gnl The reader.
+ * @param fd Its file descriptor.
+ * @note One fstat, only while the reader holds bytes and reuse is suspected
+ * (see above); no syscall otherwise.
+ */
+void	gnl_check_fd(t_gnl *gnl, int fd)
+{
+	struct stat	st;
+
+	if (!gnl_store_len(&gnl->store))
+		gnl->known = 0;
+	if (!gnl->known || (!gnl->suspect && gnl->gen == generation(0)))
+		return ;
+	gnl->suspect = 0;
+	gnl->gen = generation(0);
+	if (fstat(fd, &st) == -1)
+		return ;
+	if (st.st_dev != gnl->dev || st.st_ino != gnl->ino)
+		drop(gnl);
+}
+
+#endif
+
+/**
+ * @brief Drops the state of a fd: the bytes read but not returned yet, and
+ * its settings (gnl_set_cache, gnl_set_direct buffers, gnl_open_source). The
+ * fd itself is left open.
+ * @param fd The file descriptor.
+ * @note Call it when the fd number is about to refer to another file, e.g.
+ * before a dup2 onto it; gnl_close does it on close.
+ */
+void	gnl_reset(int fd)
+{
+	t_gnl	*gnl;
+
+	gnl = gnl_get(fd);
+	if (gnl)
+		drop(gnl);
+}
+
+/**
+ * @brief Closes a fd and drops its state, so that a file opened later on the
+ * same fd number starts afresh.
+ * @param fd The file descriptor.
+ * @return The return value of close.
+ */
+int	gnl_close(int fd)
+{
+	gnl_reset(fd);
+	return (close(fd));
+}
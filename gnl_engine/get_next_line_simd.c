@@ -0,0 +1,836 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_simd.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:20:44 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 15:58:37 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+#include <stdint.h>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+/*
+ * Scanning kernels. Each one has an SSE2 version, used whenever the compiler
+ * targets it (always on x86-64), and a word-at-a-time version that handles 8
+ * bytes per step with plain integer operations everywhere else. No kernel
+ * reads outside the area it is given: counts use aligned loads inside it, and
+ * searches stop their unaligned loads before its last byte. The line hash
+ * is word-at-a-time in both builds, since it consumes the words it checks.
+ * The exception is ft_strlen, which has no area: it reads whole aligned
+ * blocks, which never cross a page, and so may read past the terminator
+ * (hence NO_ASAN, like any vectorized strlen).
+ */
+
+#define ONES 0x0101010101010101ULL
+#define HIGHS 0x8080808080808080ULL
+#define MIX 0x9E3779B97F4A7C15ULL
+
+#if defined(__GNUC__) || defined(__clang__)
+# define NO_ASAN __attribute__((no_sanitize_address))
+#else
+# define NO_ASAN
+#endif
+
+/**
+ * @brief Marks the bytes of a word equal to the byte broadcast in `pattern`.
+ * @return A word with the high bit set in exactly the matching bytes.
+ * @note Unlike the classic `(x - ONES) & ~x & HIGHS` test this has no false
+ * positives, so the marks can be counted.
+ */
+static uint64_t	word_marks(uint64_t word, uint64_t pattern)
+{
+	uint64_t	x;
+
+	x = word ^ pattern;
+	return (~(((x & ~HIGHS) + ~HIGHS) | x) & HIGHS);
+}
+
+#ifdef __SSE2__
+
+/**
+ * @brief Counts a byte in 16-byte aligned blocks.
+ * @note Matches are accumulated per lane for up to 255 blocks, then summed
+ * with _mm_sad_epu8, so there is one horizontal sum per 4 KiB.
+ */
+static size_t	count_blocks(const unsigned char *p, int c, size_t n)
+{
+	__m128i		needle;
+	__m128i		lanes;
+	__m128i		total;
+	size_t		rounds;
+	uint64_t	sums[2];
+
+	needle = _mm_set1_epi8((char)c);
+	total = _mm_setzero_si128();
+	while (n)
+	{
+		lanes = _mm_setzero_si128();
+		rounds = 0;
+		while (n && rounds++ < 255)
+		{
+			lanes = _mm_sub_epi8(lanes, _mm_cmpeq_epi8(
+						_mm_load_si128((const __m128i *)p), needle));
+			p += 16;
+			n -= 16;
+		}
+		total = _mm_add_epi64(total, _mm_sad_epu8(lanes, _mm_setzero_si128()));
+	}
+	_mm_storeu_si128((__m128i *)sums, total);
+	return (sums[0] + sums[1]);
+}
+
+# define BLOCK 16
+
+#else
+
+static size_t	count_blocks(const unsigned char *p, int c, size_t n)
+{
+	uint64_t	pattern;
+	uint64_t	word;
+	size_t		count;
+
+	pattern = ONES * (unsigned char)c;
+	count = 0;
+	while (n)
+	{
+		__builtin_memcpy(&word, p, 8);
+		count += __builtin_popcountll(word_marks(word, pattern));
+		p += 8;
+		n -= 8;
+	}
+	return (count);
+}
+
+# define BLOCK 8
+
+#endif
+
+/**
+ * @brief Counts the occurrences of a byte in a memory area.
+ * @param s The memory area.
+ * @param c The byte to count (interpreted as unsigned char).
+ * @param n The size of the area.
+ * @return The number of bytes of the area equal to c.
+ */
+size_t	ft_memcount(const void *s, int c, size_t n)
+{
+	const unsigned char	*p;
+	size_t				count;
+	size_t				body;
+
+	p = (const unsigned char *)s;
+	count = 0;
+	while (n && ((uintptr_t)p & (BLOCK - 1)))
+	{
+		count += (*p++ == (unsigned char)c);
+		n--;
+	}
+	body = n & ~(size_t)(BLOCK - 1);
+	count += count_blocks(p, c, body);
+	p += body;
+	n -= body;
+	while (n--)
+		count += (*p++ == (unsigned char)c);
+	return (count);
+}
+
+#ifdef __SSE2__
+
+/**
+ * @brief Looks for a needle of at least 2 bytes at 16 positions per step.
+ * @param h The haystack.
+ * @param positions In: the number of positions where the needle may start.
+ * Out: how many of the last ones were not checked.
+ * @param n The needle.
+ * @param nlen The length of the needle.
+ * @return The first match, or NULL if none of the checked positions matches.
+ * @note A position is a candidate when the first and the last byte of the
+ * needle both match there; only candidates are compared in full. Loads are
+ * unaligned but never go past the last byte of the haystack.
+ */
+static const char	*memmem_blocks(const char *h, size_t *positions,
+		const char *n, size_t nlen)
+{
+	__m128i		first;
+	__m128i		last;
+	unsigned	mask;
+	size_t		i;
+
+	first = _mm_set1_epi8(n[0]);
+	last = _mm_set1_epi8(n[nlen - 1]);
+	i = 0;
+	while (i + 16 <= *positions)
+	{
+		mask = _mm_movemask_epi8(_mm_and_si128(
+					_mm_cmpeq_epi8(first,
+						_mm_loadu_si128((const __m128i *)(h + i))),
+					_mm_cmpeq_epi8(last,
+						_mm_loadu_si128((const __m128i *)(h + i + nlen - 1)))));
+		while (mask)
+		{
+			if (!ft_memcmp(h + i + __builtin_ctz(mask) + 1, n + 1, nlen - 2))
+				return (h + i + __builtin_ctz(mask));
+			mask &= mask - 1;
+		}
+		i += 16;
+	}
+	*positions -= i;
+	return (NULL);
+}
+
+#else
+
+static const char	*memmem_blocks(const char *h, size_t *positions,
+		const char *n, size_t nlen)
+{
+	(void)h;
+	(void)positions;
+	(void)n;
+	(void)nlen;
+	return (NULL);
+}
+
+#endif
+
+/**
+ * @brief Locates a byte string inside a memory area.
+ * @param hay The memory area to search.
+ * @param hlen The size of the area.
+ * @param needle The bytes to find.
+ * @param nlen The number of bytes to find.
+ * @return A pointer to the first occurrence of the needle, the area itself if
+ * the needle is empty, or NULL if it does not occur.
+ * @note The positions the vector loop leaves are checked by jumping from one
+ * occurrence of the first byte of the needle to the next.
+ */
+void	*ft_memmem(const void *hay, size_t hlen, const void *needle,
+		size_t nlen)
+{
+	const char	*h;
+	const char	*found;
+	size_t		left;
+
+	if (nlen == 0)
+		return ((void *)hay);
+	if (nlen > hlen)
+		return (NULL);
+	left = hlen - nlen + 1;
+	found = NULL;
+	if (nlen >= 2)
+		found = memmem_blocks(hay, &left, needle, nlen);
+	if (found)
+		return ((void *)found);
+	h = (const char *)hay + (hlen - nlen + 1 - left);
+	while (left)
+	{
+		found = ft_memchr(h, *(const unsigned char *)needle, left);
+		if (!found)
+			return (NULL);
+		if (!ft_memcmp(found, needle, nlen))
+			return ((void *)found);
+		left -= found + 1 - h;
+		h = found + 1;
+	}
+	return (NULL);
+}
+
+#ifdef __SSE2__
+
+/**
+ * @brief Finds the first byte of a memory area that is any of 3 bytes.
+ * @param s The memory area.
+ * @param n The size of the area.
+ * @param set The 3 bytes to look for; repeat one to look for fewer.
+ * @return A pointer to the first byte of the area found in the set, or NULL.
+ */
+const char	*ft_memchr3(const char *s, size_t n, const char set[3])
+{
+	__m128i		block;
+	unsigned	mask;
+
+	while (n >= 16)
+	{
+		block = _mm_loadu_si128((const __m128i *)s);
+		mask = _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(
+						_mm_cmpeq_epi8(block, _mm_set1_epi8(set[0])),
+						_mm_cmpeq_epi8(block, _mm_set1_epi8(set[1]))),
+					_mm_cmpeq_epi8(block, _mm_set1_epi8(set[2]))));
+		if (mask)
+			return (s + __builtin_ctz(mask));
+		s += 16;
+		n -= 16;
+	}
+	while (n--)
+	{
+		if (*s == set[0] || *s == set[1] || *s == set[2])
+			return (s);
+		s++;
+	}
+	return (NULL);
+}
+
+#else
+
+const char	*ft_memchr3(const char *s, size_t n, const char set[3])
+{
+	while (n--)
+	{
+		if (*s == set[0] || *s == set[1] || *s == set[2])
+			return (s);
+		s++;
+	}
+	return (NULL);
+}
+
+#endif
+
+/**
+ * @brief Folds a word into a running hash.
+ */
+static uint64_t	hash_word(uint64_t h, uint64_t word)
+{
+	h = (h ^ word) * MIX;
+	return (h ^ (h >> 29));
+}
+
+/**
+ * @brief Looks for a newline and hashes the bytes before it, 8 per step: the
+ * word that is checked for the newline is the word that is hashed.
+ * @param s The bytes. A line can be hashed in several calls, as more of it is
+ * read: each call starts where the words hashed by the previous one end.
+ * @param n The number of bytes.
+ * @param h The running hash, updated.
+ * @return The index of the newline, or -1. If it is found, all the bytes
+ * before it are hashed (the last ones zero-padded to a word); if not, only
+ * the n / 8 whole words are.
+ * @note Words are loaded unaligned, never past the end of the area. Hashes
+ * depend on the byte order, so they are only meant for this process.
+ */
+ssize_t	ft_memchr_hash(const char *s, size_t n, uint64_t *h)
+{
+	uint64_t	word;
+	size_t		i;
+	size_t		nl;
+
+	i = 0;
+	while (i + 8 <= n)
+	{
+		__builtin_memcpy(&word, s + i, 8);
+		if (word_marks(word, ONES * '\n'))
+			break ;
+		*h = hash_word(*h, word);
+		i += 8;
+	}
+	nl = i;
+	while (nl < n && s[nl] != '\n')
+		nl++;
+	if (nl == n)
+		return (-1);
+	if (nl > i)
+	{
+		word = 0;
+		__builtin_memcpy(&word, s + i, nl - i);
+		*h = hash_word(*h, word);
+	}
+	return (nl);
+}
+
+/**
+ * @brief Checks the UTF-8 sequence at the start of a memory area.
+ * @param s The memory area, not empty.
+ * @param n The size of the area.
+ * @return
+ * - The length of the sequence (1 to 4) if it is valid.
+ *
+ * - 0 if the area ends before the sequence, valid so far, is complete.
+ *
+ * - Minus the length of its longest valid start (at least 1 byte) if it is
+ * invalid: overlong forms, surrogates and code points past U+10FFFF included.
+ */
+ssize_t	ft_utf8_len(const char *s, size_t n)
+{
+	const unsigned char	*p;
+	size_t				len;
+	size_t				i;
+	unsigned char		lo;
+	unsigned char		hi;
+
+	p = (const unsigned char *)s;
+	if (p[0] < 0x80)
+		return (1);
+	if (p[0] < 0xC2 || p[0] > 0xF4)
+		return (-1);
+	len = 2 + (p[0] >= 0xE0) + (p[0] >= 0xF0);
+	lo = 0x80 + 0x20 * (p[0] == 0xE0) + 0x10 * (p[0] == 0xF0);
+	hi = 0xBF - 0x20 * (p[0] == 0xED) - 0x30 * (p[0] == 0xF4);
+	i = 1;
+	while (i < len)
+	{
+		if (i == n)
+			return (0);
+		if (p[i] < lo || p[i] > hi)
+			return (-(ssize_t)i);
+		lo = 0x80;
+		hi = 0xBF;
+		i++;
+	}
+	return (len);
+}
+
+#ifdef __SSE2__
+
+/**
+ * @brief Skips the bytes that are ASCII but not a newline, 16 per step.
+ * @return The index of the first other byte, or n.
+ */
+static size_t	ascii_run(const char *s, size_t i, size_t n)
+{
+	__m128i		block;
+	unsigned	mask;
+
+	while (i + 16 <= n)
+	{
+		block = _mm_loadu_si128((const __m128i *)(s + i));
+		mask = _mm_movemask_epi8(block) | _mm_movemask_epi8(
+				_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')));
+		if (mask)
+			return (i + __builtin_ctz(mask));
+		i += 16;
+	}
+	while (i < n && (unsigned char)s[i] < 0x80 && s[i] != '\n')
+		i++;
+	return (i);
+}
+
+#else
+
+static size_t	ascii_run(const char *s, size_t i, size_t n)
+{
+	uint64_t	word;
+
+	while (i + 8 <= n)
+	{
+		__builtin_memcpy(&word, s + i, 8);
+		if ((word & HIGHS) || word_marks(word, ONES * '\n'))
+			break ;
+		i += 8;
+	}
+	while (i < n && (unsigned char)s[i] < 0x80 && s[i] != '\n')
+		i++;
+	return (i);
+}
+
+#endif
+
+/**
+ * @brief Looks for a newline and checks that the bytes before it are valid
+ * UTF-8, in the same pass: ASCII runs are skipped a block at a time, and only
+ * the other bytes go through ft_utf8_len.
+ * @param s The bytes, starting at the start of a UTF-8 sequence.
+ * @param n The number of bytes.
+ * @param checked Out: the length of the valid start of the area (stops short
+ * of the end only on an invalid or incomplete last sequence).
+ * @param bad Out: 1 if the bytes at `checked` are invalid, 0 if they are just
+ * incomplete (more bytes may complete them) or if there are none.
+ * @return The index of the newline, or -1.
+ */
+ssize_t	ft_memchr_utf8(const char *s, size_t n, size_t *checked, int *bad)
+{
+	size_t		i;
+	ssize_t		len;
+	const char	*nl;
+
+	*bad = 0;
+	i = 0;
+	while (1)
+	{
+		i = ascii_run(s, i, n);
+		*checked = i;
+		if (i == n)
+			return (-1);
+		if (s[i] == '\n')
+			return (i);
+		len = ft_utf8_len(s + i, n - i);
+		if (len <= 0)
+			break ;
+		i += len;
+	}
+	*bad = (len < 0);
+	nl = ft_memchr(s + i, '\n', n - i);
+	if (!nl)
+		return (-1);
+	return (nl - s);
+}
+
+#ifdef __SSE2__
+
+/**
+ * @brief Tells whether 64 bytes hold the byte broadcast in needle.
+ */
+static int	any_of_64(const char *p, __m128i needle)
+{
+	const __m128i	*v;
+	__m128i			hits;
+
+	v = (const __m128i *)p;
+	hits = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(_mm_loadu_si128(v), needle),
+				_mm_cmpeq_epi8(_mm_loadu_si128(v + 1), needle)),
+			_mm_or_si128(_mm_cmpeq_epi8(_mm_loadu_si128(v + 2), needle),
+				_mm_cmpeq_epi8(_mm_loadu_si128(v + 3), needle)));
+	return (_mm_movemask_epi8(hits) != 0);
+}
+
+/**
+ * @brief Scans memory for the first occurrence of a byte, 64 bytes per step
+ * while there is no match, then 16.
+ * @param s The memory area to scan.
+ * @param c The byte to find (interpreted as unsigned char).
+ * @param n The number of bytes to scan.
+ * @return A pointer to the matching byte, or NULL if it is not in the area.
+ */
+void	*ft_memchr(const void *s, int c, size_t n)
+{
+	const char	*p;
+	__m128i		needle;
+	unsigned	mask;
+
+	p = (const char *)s;
+	needle = _mm_set1_epi8((char)c);
+	while (n >= 64 && !any_of_64(p, needle))
+	{
+		p += 64;
+		n -= 64;
+	}
+	while (n >= 16)
+	{
+		mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_loadu_si128((const __m128i *)p), needle));
+		if (mask)
+			return ((void *)(p + __builtin_ctz(mask)));
+		p += 16;
+		n -= 16;
+	}
+	while (n--)
+	{
+		if (*p == (char)c)
+			return ((void *)p);
+		p++;
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Computes the length of a string, 16 bytes per step.
+ * @param s The string to measure.
+ * @return The number of characters in the string, excluding the null
+ * terminator.
+ * @note The first block is the aligned one holding s, its bytes before s
+ * masked out; every load is aligned, so none crosses into another page.
+ */
+NO_ASAN size_t	ft_strlen(const char *s)
+{
+	const char	*p;
+	unsigned	mask;
+
+	p = (const char *)((uintptr_t)s & ~(uintptr_t)15);
+	mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+				_mm_load_si128((const __m128i *)p), _mm_setzero_si128()));
+	mask >>= s - p;
+	if (mask)
+		return (__builtin_ctz(mask));
+	while (1)
+	{
+		p += 16;
+		mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)p), _mm_setzero_si128()));
+		if (mask)
+			return (p + __builtin_ctz(mask) - s);
+	}
+}
+
+/**
+ * @brief Copies n bytes from src to dest, 64 then 16 bytes per step. The
+ * areas must not overlap.
+ * @param dest The destination memory area.
+ * @param src The source memory area.
+ * @param n The number of bytes to copy.
+ * @return A pointer to dest.
+ */
+void	*ft_memcpy(void *dest, const void *src, size_t n)
+{
+	__m128i			*d;
+	const __m128i	*s;
+
+	d = (__m128i *)dest;
+	s = (const __m128i *)src;
+	while (n >= 64)
+	{
+		_mm_storeu_si128(d, _mm_loadu_si128(s));
+		_mm_storeu_si128(d + 1, _mm_loadu_si128(s + 1));
+		_mm_storeu_si128(d + 2, _mm_loadu_si128(s + 2));
+		_mm_storeu_si128(d + 3, _mm_loadu_si128(s + 3));
+		d += 4;
+		s += 4;
+		n -= 64;
+	}
+	while (n >= 16)
+	{
+		_mm_storeu_si128(d++, _mm_loadu_si128(s++));
+		n -= 16;
+	}
+	while (n--)
+		((char *)d)[n] = ((const char *)s)[n];
+	return (dest);
+}
+
+#else
+
+void	*ft_memchr(const void *s, int c, size_t n)
+{
+	const char	*p;
+	uint64_t	word;
+
+	p = (const char *)s;
+	while (n >= 8)
+	{
+		__builtin_memcpy(&word, p, 8);
+		if (word_marks(word, ONES * (unsigned char)c))
+			break ;
+		p += 8;
+		n -= 8;
+	}
+	while (n--)
+	{
+		if (*p == (char)c)
+			return ((void *)p);
+		p++;
+	}
+	return (NULL);
+}
+
+NO_ASAN size_t	ft_strlen(const char *s)
+{
+	const char	*p;
+	uint64_t	word;
+
+	p = s;
+	while ((uintptr_t)p & 7)
+	{
+		if (!*p)
+			return (p - s);
+		p++;
+	}
+	__builtin_memcpy(&word, p, 8);
+	while (!((word - ONES) & ~word & HIGHS))
+	{
+		p += 8;
+		__builtin_memcpy(&word, p, 8);
+	}
+	while (*p)
+		p++;
+	return (p - s);
+}
+
+void	*ft_memcpy(void *dest, const void *src, size_t n)
+{
+	char		*d;
+	const char	*s;
+	uint64_t	word;
+
+	d = (char *)dest;
+	s = (const char *)src;
+	while (n >= 8)
+	{
+		__builtin_memcpy(&word, s, 8);
+		__builtin_memcpy(d, &word, 8);
+		d += 8;
+		s += 8;
+		n -= 8;
+	}
+	while (n--)
+		d[n] = s[n];
+	return (dest);
+}
+
+#endif
+
+/* ************************************************************************** */
+/* ************************* UNCOMMENT FOR TESTING  ************************* */
+/* ************************************************************************** */
+
+// Checks the kernels against <string.h> and the search kernels against byte
+// loops, at every alignment and every length up to 100, then times them
+// against glibc. Build with and without -mno-sse2, and with -fno-builtin so
+// the compiler does not swap the loops for the libc calls:
+// cc -O2 -fno-builtin get_next_line_simd.c get_next_line_utils.c
+// #include <assert.h>
+// #include <string.h>
+// #include <time.h>
+
+// static size_t	ref_count(const char *s, int c, size_t n)
+// {
+// 	size_t	count;
+
+// 	count = 0;
+// 	while (n--)
+// 		count += (s[n] == c);
+// 	return (count);
+// }
+
+// static const char	*ref_memmem(const char *s, size_t n, const char *needle,
+// 		size_t nlen)
+// {
+// 	size_t	i;
+
+// 	for (i = 0; i + nlen <= n; i++)
+// 		if (!memcmp(s + i, needle, nlen))
+// 			return (s + i);
+// 	return (NULL);
+// }
+
+// static const char	*ref_memchr3(const char *s, size_t n, const char set[3])
+// {
+// 	size_t	i;
+
+// 	for (i = 0; i < n; i++)
+// 		if (s[i] == set[0] || s[i] == set[1] || s[i] == set[2])
+// 			return (s + i);
+// 	return (NULL);
+// }
+
+// static ssize_t	ref_hash(const char *s, size_t n, uint64_t *h)
+// {
+// 	const char	*nl;
+// 	size_t		end;
+// 	size_t		i;
+// 	uint64_t	word;
+
+// 	nl = ref_memchr3(s, n, "\n\n\n");
+// 	end = (nl ? (size_t)(nl - s) : n - n % 8);
+// 	for (i = 0; i < end; i += 8)
+// 	{
+// 		word = 0;
+// 		memcpy(&word, s + i, end - i < 8 ? end - i : 8);
+// 		*h = hash_word(*h, word);
+// 	}
+// 	return (nl ? nl - s : -1);
+// }
+
+// static ssize_t	ref_utf8(const char *s, size_t n, size_t *checked,
+// 		int *bad)
+// {
+// 	const char	*nl;
+// 	size_t		i;
+// 	ssize_t		len;
+
+// 	i = 0;
+// 	len = 1;
+// 	while (i < n && s[i] != '\n' && len > 0)
+// 	{
+// 		len = ((unsigned char)s[i] < 0x80 ? 1 : ft_utf8_len(s + i, n - i));
+// 		i += (len > 0 ? len : 0);
+// 	}
+// 	*checked = i;
+// 	*bad = (len < 0);
+// 	nl = ref_memchr3(s + i, n - i, "\n\n\n");
+// 	return (nl ? nl - s : -1);
+// }
+
+// // Kind 0 has no newline, kind 1 one in the last byte, kind 2 also an invalid
+// // UTF-8 byte in the middle.
+// static void	check_kernels(void)
+// {
+// 	static char	b[128];
+// 	const char	*set = "\n\xff\x82";
+// 	const char	*nd = "d\xe2\x82\n";
+// 	size_t		n, i, c[2];
+// 	int			al, kind, bad[2];
+// 	uint64_t	h[2];
+// 	char		*s;
+
+// 	for (al = 0; al < 16; al++)
+// 	for (n = 0; n <= 100; n++)
+// 	for (kind = 0; kind < 3; kind++)
+// 	{
+// 		s = b + al;
+// 		for (i = 0; i < n; i++)
+// 			s[i] = "ab\xc3\xa9" "cd\xe2\x82\xac"[i % 9];
+// 		if (kind && n)
+// 			s[n - 1] = '\n';
+// 		if (kind == 2)
+// 			s[n / 2] = '\xff';
+// 		assert(ft_memcount(s, '\n', n) == ref_count(s, '\n', n));
+// 		assert(ft_memcount(s, 'a', n) == ref_count(s, 'a', n));
+// 		assert(ft_memchr3(s, n, set) == ref_memchr3(s, n, set));
+// 		assert(ft_memchr3(s, n, "\n\n\n") == ref_memchr3(s, n, "\n\n\n"));
+// 		assert(ft_memmem(s, n, nd, 4) == ref_memmem(s, n, nd, 4));
+// 		assert(ft_memmem(s, n, s + n / 3, n - n / 3)
+// 			== ref_memmem(s, n, s + n / 3, n - n / 3));
+// 		h[0] = 1;
+// 		h[1] = 1;
+// 		assert(ft_memchr_hash(s, n, &h[0]) == ref_hash(s, n, &h[1]));
+// 		assert(h[0] == h[1]);
+// 		assert(ft_memchr_utf8(s, n, &c[0], &bad[0])
+// 			== ref_utf8(s, n, &c[1], &bad[1]));
+// 		assert(c[0] == c[1] && bad[0] == bad[1]);
+// 	}
+// }
+
+// static double	gbps(struct timespec t0, size_t bytes)
+// {
+// 	struct timespec	t1;
+
+// 	clock_gettime(CLOCK_MONOTONIC, &t1);
+// 	return (bytes / ((t1.tv_sec - t0.tv_sec) * 1e9
+// 			+ (t1.tv_nsec - t0.tv_nsec)));
+// }
+
+// int	main(void)
+// {
+// 	static char		a[1 << 16];
+// 	static char		b[1 << 16];
+// 	size_t			i;
+// 	size_t			n;
+// 	struct timespec	t;
+
+// 	check_kernels();
+// 	memset(a, 'x', sizeof(a));
+// 	i = 0;
+// 	while (i < 64 * 300)
+// 	{
+// 		n = i % 300;
+// 		a[i / 300 + n] = '\0';
+// 		assert(ft_strlen(a + i / 300) == strlen(a + i / 300));
+// 		assert(ft_memchr(a, '\0', i / 300 + n + 1) == a + i / 300 + n);
+// 		a[i / 300 + n] = 'x';
+// 		ft_memcpy(b + n % 16, a + i / 300, n);
+// 		assert(!memcmp(b + n % 16, a + i / 300, n));
+// 		i++;
+// 	}
+// 	a[sizeof(a) - 1] = '\0';
+// 	clock_gettime(CLOCK_MONOTONIC, &t);
+// 	for (i = 0; i < 20000; i++)
+// 		n += ft_memchr(a + i % 8, '\n', sizeof(a) - 8) == NULL;
+// 	printf("ft_memchr %.1f GB/s\n", gbps(t, 20000 * sizeof(a)));
+// 	clock_gettime(CLOCK_MONOTONIC, &t);
+// 	for (i = 0; i < 20000; i++)
+// 		n += memchr(a + i % 8, '\n', sizeof(a) - 8) == NULL;
+// 	printf("memchr    %.1f GB/s\n", gbps(t, 20000 * sizeof(a)));
+// 	clock_gettime(CLOCK_MONOTONIC, &t);
+// 	for (i = 0; i < 20000; i++)
+// 		n += ft_strlen(a + i % 8);
+// 	printf("ft_strlen %.1f GB/s\n", gbps(t, 20000 * sizeof(a)));
+// 	clock_gettime(CLOCK_MONOTONIC, &t);
+// 	for (i = 0; i < 20000; i++)
+// 		n += strlen(a + i % 8);
+// 	printf("strlen    %.1f GB/s\n", gbps(t, 20000 * sizeof(a)));
+// 	return (n == 0);
+// }
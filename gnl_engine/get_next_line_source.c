@@ -0,0 +1,108 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_source.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 02:31:40 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 15:41:18 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+#include <errno.h>
+
+/*
+ * Sources other than fds. A source is bound to the reader of a descriptor
+ * opened on /dev/null: its number is unique, and gnl_close releases it like
+ * any other. Only gnl_fill reads from the source, so get_next_line,
+ * gnl_next_view, gnl_for_each_line and the gnl_next_* readers all serve its
+ * lines; gnl_count_lines, gnl_copy_lines, gnl_follow and gnl_pipeline call the
+ * kernel on the fd themselves, and fail with EINVAL on a source rather than
+ * miss its lines. Sources need GNL_MULTI_FD: with a single reader shared by
+ * every fd, a source would serve them all.
+ */
+
+/**
+ * @brief Memory read by copies, for storages that cannot borrow it.
+ */
+typedef struct s_memory
+{
+	const char	*data;
+	size_t		len;
+	size_t		pos;
+}	t_memory;
+
+static ssize_t	memory_read(void *ctx, char *buf, size_t len)
+{
+	t_memory	*mem;
+
+	mem = (t_memory *)ctx;
+	if (len > mem->len - mem->pos)
+		len = mem->len - mem->pos;
+	ft_memcpy(buf, mem->data + mem->pos, len);
+	mem->pos += len;
+	return (len);
+}
+
+static const t_gnl_source	g_copied = {memory_read, free};
+static const t_gnl_source	g_borrowed = {NULL, NULL};
+
+/**
+ * @brief Returns a descriptor whose lines are read from a callback.
+ * @param source The callbacks, which must stay valid until gnl_close.
+ * @param ctx Passed to the callbacks.
+ * @return The descriptor, to be given to get_next_line and the others and
+ * released with gnl_close, or -1 if it cannot be opened (errno is set; ctx is
+ * not closed). errno is EINVAL in single-reader builds (GNL_MULTI_FD 0).
+ */
+int	gnl_open_source(const t_gnl_source *source, void *ctx)
+{
+	t_gnl	*gnl;
+	int		fd;
+
+	if (!source || !GNL_MULTI_FD)
+		return (errno = EINVAL, -1);
+	fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return (-1);
+	gnl = gnl_get(fd);
+	if (!gnl)
+		return (close(fd), errno = EMFILE, -1);
+	gnl_reset(fd);
+	gnl->source = source;
+	gnl->ctx = ctx;
+	return (fd);
+}
+
+/**
+ * @brief Returns a descriptor whose lines are read from memory.
+ * @param data The bytes, which must stay valid and unchanged until gnl_close.
+ * @param len Their number.
+ * @return The descriptor, or -1 if it cannot be opened (errno is set, EINVAL
+ * in single-reader builds, see gnl_open_source).
+ * @note With GNL_STORAGE_BUF the reader points into data instead of copying
+ * it: gnl_next_view returns views into data itself, and nothing is ever
+ * copied. Other storages copy data in, BUFFER_SIZE bytes at a time.
+ */
+int	gnl_open_memory(const char *data, size_t len)
+{
+	t_gnl		*gnl;
+	t_memory	*mem;
+	int			fd;
+
+	fd = gnl_open_source(&g_borrowed, NULL);
+	if (fd == -1)
+		return (-1);
+	gnl = gnl_get(fd);
+	if (gnl_store_borrow(&gnl->store, data, len) == 0)
+		return (fd);
+	mem = (t_memory *)malloc(sizeof(t_memory));
+	if (!mem)
+		return (gnl_close(fd), errno = ENOMEM, -1);
+	*mem = (t_memory){data, len, 0};
+	gnl->source = &g_copied;
+	gnl->ctx = mem;
+	return (fd);
+}
@@ -0,0 +1,224 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_stats.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 22:38:40 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 17:20:14 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+#include <inttypes.h>
+
+#if GNL_STATS
+
+# include <time.h>
+# if GNL_STATS_TSC
+#  include <x86intrin.h>
+#  define UNIT "cycles"
+# else
+#  define UNIT "ns"
+# endif
+
+/*
+ * Latency histograms, one per phase (GNL_PHASE_READ, _SCAN, _COPY, _CALL),
+ * log-linear as in HdrHistogram: values below 2^SUB_BITS get a bucket each,
+ * then every power of two is split into 2^SUB_BITS buckets, so any value is
+ * known within 1 / 2^SUB_BITS (about 3%) from 1 ns to MAX_BITS (18 minutes),
+ * in a fixed 9 KiB per phase. Recording is one clock read, a count leading
+ * zeros and an increment: no allocation, no lock (the engine is not thread
+ * safe either).
+ */
+
+# define SUB_BITS 5
+# define MAX_BITS 40
+# define BUCKETS 1152 // (MAX_BITS - SUB_BITS + 1) << SUB_BITS
+
+/**
+ * @brief One histogram: the counts of each bucket, plus exact totals.
+ */
+typedef struct s_hist
+{
+	uint64_t	counts[BUCKETS];
+	uint64_t	total;
+	uint64_t	sum;
+	uint64_t	max;
+}	t_hist;
+
+static t_hist	g_hists[GNL_PHASES];
+
+static const char	*g_names[GNL_PHASES] = {"read", "scan", "copy", "call"};
+
+# if GNL_STATS_TSC
+
+static uint64_t	gnl_tsc(void)
+{
+	return (__rdtsc());
+}
+
+# else
+
+static uint64_t	gnl_tsc(void)
+{
+	return (0);
+}
+
+# endif
+
+/**
+ * @brief Returns the current time, in nanoseconds (or cycles with
+ * GNL_STATS_TSC).
+ */
+uint64_t	gnl_stats_now(void)
+{
+	struct timespec	now;
+
+	if (GNL_STATS_TSC)
+		return (gnl_tsc());
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec);
+}
+
+/**
+ * @brief Returns the bucket of a value.
+ */
+static size_t	bucket_of(uint64_t value)
+{
+	int	shift;
+
+	if (value >> MAX_BITS)
+		return (BUCKETS - 1);
+	if (value < (1ULL << SUB_BITS))
+		return (value);
+	shift = 63 - __builtin_clzll(value) - SUB_BITS;
+	return (((size_t)shift << SUB_BITS) + (value >> shift));
+}
+
+/**
+ * @brief Returns the highest value that falls in a bucket.
+ */
+static uint64_t	bucket_value(size_t bucket)
+{
+	int	shift;
+
+	if (bucket < (1U << SUB_BITS) * 2)
+		return (bucket);
+	shift = (bucket >> SUB_BITS) - 1;
+	return ((((bucket - ((size_t)shift << SUB_BITS)) + 1) << shift) - 1);
+}
+
+/**
+ * @brief Records the time elapsed since `start` in a phase's histogram.
+ * @param phase The phase, GNL_PHASE_*.
+ * @param start A time returned by gnl_stats_now.
+ */
+void	gnl_stats_record(int phase, uint64_t start)
+{
+	t_hist		*h;
+	uint64_t	value;
+
+	value = gnl_stats_now() - start;
+	h = &g_hists[phase];
+	h->counts[bucket_of(value)]++;
+	h->total++;
+	h->sum += value;
+	if (value > h->max)
+		h->max = value;
+}
+
+/**
+ * @brief Returns a percentile of a phase's latencies.
+ * @param phase The phase, GNL_PHASE_*.
+ * @param percentile The percentile, from 0 to 100 (99.9 for p99.9).
+ * @return The latency, rounded up to its bucket (exact for the maximum), or
+ * 0 if nothing was recorded.
+ */
+uint64_t	gnl_stats_value_at(int phase, double percentile)
+{
+	const t_hist	*h;
+	uint64_t		rank;
+	uint64_t		seen;
+	size_t			i;
+
+	h = &g_hists[phase];
+	if (!h->total)
+		return (0);
+	rank = (uint64_t)(percentile / 100.0 * h->total);
+	if ((double)rank < percentile / 100.0 * h->total || rank < 1)
+		rank++;
+	if (rank >= h->total)
+		return (h->max);
+	seen = 0;
+	i = 0;
+	while (seen + h->counts[i] < rank)
+		seen += h->counts[i++];
+	if (bucket_value(i) > h->max)
+		return (h->max);
+	return (bucket_value(i));
+}
+
+/**
+ * @brief Writes every non-empty bucket as "phase highest_value count".
+ * @return 0 on success, -1 on write error.
+ */
+static int	dump_buckets(int fd)
+{
+	int		p;
+	size_t	i;
+
+	p = -1;
+	while (++p < GNL_PHASES)
+	{
+		i = -1;
+		while (++i < BUCKETS)
+			if (g_hists[p].counts[i]
+				&& dprintf(fd, "%s %" PRIu64 " %" PRIu64 "\n", g_names[p],
+					bucket_value(i), g_hists[p].counts[i]) < 0)
+				return (-1);
+	}
+	return (0);
+}
+
+/**
+ * @brief Writes the histograms: a summary line per phase (count, mean,
+ * p50, p90, p99, p99.9, max), then every non-empty bucket as
+ * "phase highest_value count", for tools that merge or plot them.
+ * @param fd Where to write.
+ * @return 0 on success, -1 on write error.
+ */
+int	gnl_stats_dump(int fd)
+{
+	const t_hist	*h;
+	int				p;
+
+	if (dprintf(fd, "# phase count mean p50 p90 p99 p99.9 max (" UNIT ")\n")
+		< 0)
+		return (-1);
+	p = -1;
+	while (++p < GNL_PHASES)
+	{
+		h = &g_hists[p];
+		if (dprintf(fd, "%s %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64
+				" %" PRIu64 " %" PRIu64 " %" PRIu64 "\n", g_names[p],
+				h->total, h->sum / (h->total + !h->total),
+				gnl_stats_value_at(p, 50), gnl_stats_value_at(p, 90),
+				gnl_stats_value_at(p, 99), gnl_stats_value_at(p, 99.9),
+				h->max) < 0)
+			return (-1);
+	}
+	return (dump_buckets(fd));
+}
+
+void	gnl_stats_reset(void)
+{
+	int	p;
+
+	p = -1;
+	while (++p < GNL_PHASES)
+		g_hists[p] = (t_hist){{0}, 0, 0, 0};
+}
+
+#endif
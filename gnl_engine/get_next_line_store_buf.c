@@ -0,0 +1,226 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_store_buf.c                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:10:52 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 16:39:10 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+
+#if GNL_STORAGE == GNL_STORAGE_BUF
+
+/*
+ * Contiguous storage: pending bytes are data[start, end). Consuming only moves
+ * start; the bytes are moved to the front when the tail runs out of room, and
+ * the buffer grows (doubling) only when the pending bytes do not leave room
+ * for another read.
+ * Aligned stores (see gnl_set_direct) are mapped with gnl_map instead, and
+ * keep the end of the pending bytes and the room after it aligned, so that
+ * reads can go straight from the disk into them with O_DIRECT.
+ * Borrowed stores (see gnl_open_memory) point into the caller's memory:
+ * nothing is ever written to it or freed, the first reserve moves the pending
+ * bytes to a buffer of their own, and the memory budget only counts them
+ * from then on.
+ */
+
+size_t	gnl_store_len(const t_store *st)
+{
+	return (st->end - st->start);
+}
+
+ssize_t	gnl_store_find(const t_store *st, size_t from, int c)
+{
+	char	*found;
+
+	if (st->start + from >= st->end)
+		return (-1);
+	found = ft_memchr(st->data + st->start + from, c,
+			st->end - st->start - from);
+	if (!found)
+		return (-1);
+	return (found - (st->data + st->start));
+}
+
+/**
+ * @brief Moves the pending bytes of an aligned store so that they end on an
+ * alignment boundary with at least `room` bytes after them, remapping the
+ * store if it is too small.
+ * @return 0 on success, -1 if the mapping fails.
+ * @note Only the pending bytes are moved: in practice the part of a line that
+ * straddles the end of the last read.
+ */
+static int	align_tail(t_store *st, size_t room)
+{
+	char	*map;
+	size_t	len;
+	size_t	start;
+	size_t	cap;
+
+	len = st->end - st->start;
+	start = (len + st->align - 1) / st->align * st->align - len;
+	cap = st->cap;
+	while (cap < start + len + room)
+		cap = cap * 2 + (cap == 0) * GNL_DIRECT_SIZE;
+	map = st->data;
+	if (cap != st->cap)
+		map = gnl_map(cap, st->huge);
+	if (!map)
+		return (-1);
+	if (len)
+		ft_memmove(map + start, st->data + st->start, len);
+	if (map != st->data && st->cap)
+		gnl_unmap(st->data, st->cap);
+	*st = (t_store){map, start, start + len, cap, st->align, st->huge, 0,
+		st->alloc};
+	return (0);
+}
+
+/**
+ * @brief Returns the free tail of the buffer, making room for *room bytes.
+ * @param st The store.
+ * @param room In: the minimum room wanted. Out: the room available.
+ * @return A pointer to the free tail, or NULL if memory allocation fails.
+ */
+char	*gnl_store_reserve(t_store *st, size_t *room)
+{
+	char	*bigger;
+	size_t	len;
+	size_t	cap;
+
+	len = st->end - st->start;
+	if (st->align)
+	{
+		if (((st->end % st->align) || st->cap - st->end < *room)
+			&& align_tail(st, (*room + st->align - 1) / st->align * st->align))
+			return (NULL);
+	}
+	else if (st->cap - st->end < *room && st->cap - len >= *room && st->start
+		&& !st->borrowed)
+	{
+		ft_memmove(st->data, st->data + st->start, len);
+		st->start = 0;
+		st->end = len;
+	}
+	if (st->cap - st->end < *room || st->borrowed)
+	{
+		cap = st->cap * 2 * !st->borrowed;
+		if (cap < len + *room)
+			cap = len + *room;
+		bigger = (char *)gnl_alloc(&st->alloc, cap * sizeof(char));
+		if (!bigger)
+			return (NULL);
+		if (len)
+			ft_memcpy(bigger, st->data + st->start, len);
+		if (st->borrowed)
+			GNL_BUDGET_MOVE(0, len);
+		else
+			gnl_free(&st->alloc, st->data, st->cap);
+		*st = (t_store){bigger, 0, len, cap, 0, 0, 0, st->alloc};
+	}
+	*room = st->cap - st->end;
+	return (st->data + st->end);
+}
+
+/**
+ * @brief Returns the free tail for a vectored read of `room` bytes: always a
+ * single vector, the buffer being grown to hold them.
+ * @return 1, or 0 if memory allocation fails.
+ */
+int	gnl_store_reserve_iov(t_store *st, struct iovec *iov, size_t room)
+{
+	iov[0].iov_base = gnl_store_reserve(st, &room);
+	iov[0].iov_len = room;
+	return (iov[0].iov_base != NULL);
+}
+
+void	gnl_store_commit(t_store *st, size_t n)
+{
+	GNL_BUDGET_MOVE(st->end - st->start, st->end - st->start + n);
+	st->end += n;
+}
+
+void	gnl_store_copy(const t_store *st, char *dst, size_t n)
+{
+	ft_memcpy(dst, st->data + st->start, n);
+}
+
+char	*gnl_store_data(t_store *st)
+{
+	if (!st->data)
+		return (NULL);
+	return (st->data + st->start);
+}
+
+void	gnl_store_consume(t_store *st, size_t n)
+{
+	if (!st->borrowed)
+		GNL_BUDGET_MOVE(st->end - st->start, st->end - st->start - n);
+	st->start += n;
+	if (st->start == st->end)
+	{
+		st->start = 0;
+		st->end = 0;
+	}
+}
+
+/**
+ * @brief Makes the store aligned: from now on it is mapped with gnl_map and
+ * reserves aligned room. Pending bytes are kept; borrowed ones are copied, and
+ * count towards the budget from then on.
+ * @param st The store.
+ * @param align The alignment of the reads (a power of two).
+ * @param huge How to back the mappings with huge pages, see gnl_map.
+ * @return 0 on success, -1 if the mapping fails (the store is unchanged).
+ */
+int	gnl_store_align(t_store *st, size_t align, int huge)
+{
+	t_store	old;
+
+	if (st->align)
+		return (0);
+	old = *st;
+	*st = (t_store){old.data, old.start, old.end, 0, align, huge, 0, old.alloc};
+	if (align_tail(st, GNL_DIRECT_SIZE - align))
+	{
+		*st = old;
+		return (-1);
+	}
+	if (old.borrowed)
+		GNL_BUDGET_MOVE(0, old.end - old.start);
+	else
+		gnl_free(&old.alloc, old.data, old.cap);
+	return (0);
+}
+
+/**
+ * @brief Makes the store point into the caller's memory instead of a buffer
+ * of its own: the bytes are pending as they are, without a copy.
+ * @param st The store.
+ * @param data The bytes, left untouched and not freed by the store.
+ * @param len Their number.
+ * @return 0.
+ */
+int	gnl_store_borrow(t_store *st, const char *data, size_t len)
+{
+	gnl_store_clear(st);
+	*st = (t_store){(char *)data, 0, len, len, 0, 0, 1, st->alloc};
+	return (0);
+}
+
+void	gnl_store_clear(t_store *st)
+{
+	if (!st->borrowed)
+		GNL_BUDGET_MOVE(st->end - st->start, 0);
+	if (st->align && st->data)
+		gnl_unmap(st->data, st->cap);
+	else if (!st->borrowed)
+		gnl_free(&st->alloc, st->data, st->cap);
+	*st = (t_store){NULL, 0, 0, 0, st->align, st->huge, 0, st->alloc};
+}
+
+#endif
@@ -0,0 +1,288 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_store_list.c                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:21:06 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 11:26:48 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+
+#if GNL_STORAGE == GNL_STORAGE_LIST
+
+/*
+ * Chunk list storage: each read lands directly in the free space of the last
+ * chunk, or in a new chunk of at least BUFFER_SIZE bytes appended to the list.
+ * Pending bytes start `off` bytes into the first chunk. Chunks are freed as
+ * soon as they are fully consumed, except the last one, which is reused, and
+ * one kept aside as the spare chunk: the next chunk needed is taken from it
+ * instead of a new allocation, and a vectored read fills the end of the last
+ * chunk and the spare at once.
+ * Searches starting in the last chunk go straight to it, so looking for a
+ * newline in the bytes of the last read does not walk the whole list.
+ */
+
+size_t	gnl_store_len(const t_store *st)
+{
+	return (st->len);
+}
+
+ssize_t	gnl_store_find(const t_store *st, size_t from, int c)
+{
+	t_chunk	*chunk;
+	size_t	base;
+	size_t	skip;
+	char	*found;
+
+	chunk = st->head;
+	base = 0;
+	skip = st->off;
+	if (st->tail && st->tail != st->head && from >= st->len - st->tail->len)
+	{
+		chunk = st->tail;
+		base = st->len - st->tail->len;
+		skip = 0;
+	}
+	while (chunk)
+	{
+		if (from < base + chunk->len - skip)
+		{
+			found = ft_memchr(chunk->data + skip + (from - base), c,
+					chunk->len - skip - (from - base));
+			if (found)
+				return (base + (found - (chunk->data + skip)));
+			from = base + chunk->len - skip;
+		}
+		base += chunk->len - skip;
+		skip = 0;
+		chunk = chunk->next;
+	}
+	return (-1);
+}
+
+/**
+ * @brief Frees a chunk (if not NULL) with the allocator of the store.
+ */
+static void	free_chunk(t_store *st, t_chunk *chunk)
+{
+	if (chunk)
+		gnl_free(&st->alloc, chunk, sizeof(t_chunk) + chunk->cap);
+}
+
+/**
+ * @brief Takes a new chunk of at least `size` bytes: the spare one if it is
+ * big enough, else a new allocation (the spare is then freed).
+ * @return The empty chunk, or NULL if memory allocation fails.
+ */
+static t_chunk	*take_chunk(t_store *st, size_t size)
+{
+	t_chunk	*new;
+
+	new = st->spare;
+	st->spare = NULL;
+	if (new && new->cap >= size)
+		return (*new = (t_chunk){0, new->cap, NULL}, new);
+	free_chunk(st, new);
+	new = (t_chunk *)gnl_alloc(&st->alloc, sizeof(t_chunk) + size);
+	if (new)
+		*new = (t_chunk){0, size, NULL};
+	return (new);
+}
+
+/**
+ * @brief Returns the free space of the last chunk, appending a new chunk when
+ * the last one is full.
+ * @param st The store.
+ * @param room In: the size of a new chunk, if one is needed. Out: the room
+ * available in the last chunk.
+ * @return A pointer to the free space, or NULL if memory allocation fails.
+ */
+char	*gnl_store_reserve(t_store *st, size_t *room)
+{
+	t_chunk	*new;
+
+	if (!st->tail || st->tail->len == st->tail->cap)
+	{
+		new = take_chunk(st, *room);
+		if (!new)
+			return (NULL);
+		if (st->tail)
+			st->tail->next = new;
+		else
+			st->head = new;
+		st->tail = new;
+	}
+	*room = st->tail->cap - st->tail->len;
+	return (st->tail->data + st->tail->len);
+}
+
+/**
+ * @brief Returns the free space for a vectored read of `room` bytes: the end
+ * of the last chunk and, if that is too short, the spare chunk.
+ * @return The number of vectors (1 or 2), 0 if memory allocation fails.
+ */
+int	gnl_store_reserve_iov(t_store *st, struct iovec *iov, size_t room)
+{
+	size_t	left;
+
+	if (st->tail && st->tail->len < st->tail->cap
+		&& st->tail->cap - st->tail->len < room)
+	{
+		left = st->tail->cap - st->tail->len;
+		if (!st->spare || st->spare->cap < room - left)
+			st->spare = take_chunk(st, room - left);
+		iov[0] = (struct iovec){st->tail->data + st->tail->len, left};
+		if (!st->spare)
+			return (1);
+		iov[1] = (struct iovec){st->spare->data, st->spare->cap};
+		return (2);
+	}
+	iov[0].iov_base = gnl_store_reserve(st, &room);
+	iov[0].iov_len = room;
+	return (iov[0].iov_base != NULL);
+}
+
+/**
+ * @brief Marks bytes read into the reserved space as pending. Bytes past the
+ * end of the last chunk went to the spare chunk, which is appended.
+ */
+void	gnl_store_commit(t_store *st, size_t n)
+{
+	size_t	part;
+
+	GNL_BUDGET_MOVE(st->len, st->len + n);
+	st->len += n;
+	part = st->tail->cap - st->tail->len;
+	if (part > n)
+		part = n;
+	st->tail->len += part;
+	if (part == n)
+		return ;
+	st->tail->next = st->spare;
+	st->tail = st->spare;
+	st->spare = NULL;
+	st->tail->len = n - part;
+}
+
+void	gnl_store_copy(const t_store *st, char *dst, size_t n)
+{
+	t_chunk	*chunk;
+	size_t	skip;
+	size_t	part;
+
+	chunk = st->head;
+	skip = st->off;
+	while (n)
+	{
+		part = chunk->len - skip;
+		if (part > n)
+			part = n;
+		ft_memcpy(dst, chunk->data + skip, part);
+		dst += part;
+		n -= part;
+		skip = 0;
+		chunk = chunk->next;
+	}
+}
+
+/**
+ * @brief Frees every chunk of the store.
+ */
+static void	free_chunks(t_store *st)
+{
+	t_chunk	*next;
+
+	while (st->head)
+	{
+		next = st->head->next;
+		free_chunk(st, st->head);
+		st->head = next;
+	}
+}
+
+/**
+ * @brief Points to the pending bytes, merging the chunks into one first if
+ * they are spread over more than one.
+ * @param st The store.
+ * @return A pointer to the first pending byte, or NULL if there are none or if
+ * memory allocation fails (the store is left untouched in that case).
+ * @note The merged chunk has room for as many bytes again, which the next
+ * reads fill in place: a caller asking again after each read (a record still
+ * growing) only has the bytes copied a logarithmic number of times.
+ */
+char	*gnl_store_data(t_store *st)
+{
+	t_chunk	*merged;
+	size_t	cap;
+
+	if (!st->len)
+		return (NULL);
+	if (st->off + st->len <= st->head->len)
+		return (st->head->data + st->off);
+	cap = st->len * 2;
+	if (cap < st->tail->cap)
+		cap = st->tail->cap;
+	merged = (t_chunk *)gnl_alloc(&st->alloc, sizeof(t_chunk) + cap);
+	if (!merged)
+		return (NULL);
+	*merged = (t_chunk){st->len, cap, NULL};
+	gnl_store_copy(st, merged->data, st->len);
+	free_chunks(st);
+	*st = (t_store){merged, merged, 0, merged->len, st->spare, st->alloc};
+	return (merged->data);
+}
+
+void	gnl_store_consume(t_store *st, size_t n)
+{
+	t_chunk	*next;
+
+	GNL_BUDGET_MOVE(st->len, st->len - n);
+	st->len -= n;
+	n += st->off;
+	while (st->head != st->tail && n >= st->head->len)
+	{
+		n -= st->head->len;
+		next = st->head->next;
+		if (st->spare)
+			free_chunk(st, st->head);
+		else
+		{
+			st->spare = st->head;
+			*st->spare = (t_chunk){0, st->spare->cap, NULL};
+		}
+		st->head = next;
+	}
+	st->off = n;
+	if (st->head && st->off == st->head->len)
+	{
+		st->head->len = 0;
+		st->off = 0;
+	}
+}
+
+/**
+ * @brief Chunks are allocated by the store: it cannot point into memory it
+ * does not own (see gnl_open_memory).
+ * @return -1.
+ */
+int	gnl_store_borrow(t_store *st, const char *data, size_t len)
+{
+	(void)st;
+	(void)data;
+	(void)len;
+	return (-1);
+}
+
+void	gnl_store_clear(t_store *st)
+{
+	GNL_BUDGET_MOVE(st->len, 0);
+	free_chunks(st);
+	free_chunk(st, st->spare);
+	*st = (t_store){NULL, NULL, 0, 0, NULL, st->alloc};
+}
+
+#endif
@@ -0,0 +1,187 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_store_ring.c                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:34:45 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/20 05:24:09 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+
+#if GNL_STORAGE == GNL_STORAGE_RING
+
+/*
+ * Ring storage: pending bytes start at data[head] and may wrap around the end
+ * of the buffer. The capacity is a power of two so positions wrap with a mask.
+ * Nothing is ever moved to make room; the ring is only reallocated when the
+ * pending bytes leave less than a read's worth of free space.
+ */
+
+size_t	gnl_store_len(const t_store *st)
+{
+	return (st->len);
+}
+
+ssize_t	gnl_store_find(const t_store *st, size_t from, int c)
+{
+	size_t	first;
+	char	*found;
+
+	if (from >= st->len)
+		return (-1);
+	first = st->cap - st->head;
+	if (first > st->len)
+		first = st->len;
+	if (from < first)
+	{
+		found = ft_memchr(st->data + st->head + from, c, first - from);
+		if (found)
+			return (found - (st->data + st->head));
+		from = first;
+	}
+	if (from >= st->len)
+		return (-1);
+	found = ft_memchr(st->data + (from - first), c, st->len - from);
+	if (!found)
+		return (-1);
+	return (first + (found - st->data));
+}
+
+/**
+ * @brief Reallocates the ring to the smallest power of two holding the pending
+ * bytes plus `room`, unwrapping them to the start of the new buffer.
+ * @return 0 on success, -1 if memory allocation fails.
+ */
+static int	grow_ring(t_store *st, size_t room)
+{
+	char	*bigger;
+	size_t	cap;
+
+	cap = 1;
+	while (cap < st->len + room || cap < st->cap * 2)
+		cap *= 2;
+	bigger = (char *)gnl_alloc(&st->alloc, cap * sizeof(char));
+	if (!bigger)
+		return (-1);
+	gnl_store_copy(st, bigger, st->len);
+	gnl_free(&st->alloc, st->data, st->cap);
+	*st = (t_store){bigger, 0, st->len, cap, st->alloc};
+	return (0);
+}
+
+/**
+ * @brief Returns the contiguous free space after the pending bytes.
+ * @param st The store.
+ * @param room In: the minimum free space wanted in the ring. Out: the room
+ * available up to the end of the buffer or up to head, whichever comes first.
+ * @return A pointer to the free space, or NULL if memory allocation fails.
+ */
+char	*gnl_store_reserve(t_store *st, size_t *room)
+{
+	size_t	tail;
+
+	if (st->cap - st->len < *room && grow_ring(st, *room) == -1)
+		return (NULL);
+	tail = (st->head + st->len) & (st->cap - 1);
+	if (tail < st->head || (tail == st->head && st->len))
+		*room = st->head - tail;
+	else
+		*room = st->cap - tail;
+	return (st->data + tail);
+}
+
+/**
+ * @brief Returns the free space for a vectored read of `room` bytes: up to the
+ * end of the buffer, then from its start up to head when the free space wraps.
+ * @return The number of vectors (1 or 2), 0 if memory allocation fails.
+ */
+int	gnl_store_reserve_iov(t_store *st, struct iovec *iov, size_t room)
+{
+	char	*tail;
+
+	tail = gnl_store_reserve(st, &room);
+	if (!tail)
+		return (0);
+	iov[0] = (struct iovec){tail, room};
+	if (tail < st->data + st->head || !st->head)
+		return (1);
+	iov[1] = (struct iovec){st->data, st->head};
+	return (2);
+}
+
+void	gnl_store_commit(t_store *st, size_t n)
+{
+	GNL_BUDGET_MOVE(st->len, st->len + n);
+	st->len += n;
+}
+
+void	gnl_store_copy(const t_store *st, char *dst, size_t n)
+{
+	size_t	first;
+
+	first = st->cap - st->head;
+	if (first > n)
+		first = n;
+	ft_memcpy(dst, st->data + st->head, first);
+	ft_memcpy(dst + first, st->data, n - first);
+}
+
+/**
+ * @brief Points to the pending bytes, unwrapping them into a new buffer first
+ * if they wrap around the end of the ring.
+ * @return A pointer to the first pending byte, or NULL if there are none or if
+ * memory allocation fails (the store is left untouched in that case).
+ */
+char	*gnl_store_data(t_store *st)
+{
+	char	*flat;
+
+	if (!st->len)
+		return (NULL);
+	if (st->head + st->len > st->cap)
+	{
+		flat = (char *)gnl_alloc(&st->alloc, st->cap * sizeof(char));
+		if (!flat)
+			return (NULL);
+		gnl_store_copy(st, flat, st->len);
+		gnl_free(&st->alloc, st->data, st->cap);
+		st->data = flat;
+		st->head = 0;
+	}
+	return (st->data + st->head);
+}
+
+void	gnl_store_consume(t_store *st, size_t n)
+{
+	GNL_BUDGET_MOVE(st->len, st->len - n);
+	st->len -= n;
+	st->head = (st->head + n) & (st->cap - 1);
+	if (!st->len)
+		st->head = 0;
+}
+
+/**
+ * @brief The ring is allocated by the store: it cannot point into memory it
+ * does not own (see gnl_open_memory).
+ * @return -1.
+ */
+int	gnl_store_borrow(t_store *st, const char *data, size_t len)
+{
+	(void)st;
+	(void)data;
+	(void)len;
+	return (-1);
+}
+
+void	gnl_store_clear(t_store *st)
+{
+	GNL_BUDGET_MOVE(st->len, 0);
+	gnl_free(&st->alloc, st->data, st->cap);
+	*st = (t_store){NULL, 0, 0, 0, st->alloc};
+}
+
+#endif
@@ -0,0 +1,189 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_utf8.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 21:40:55 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/20 00:41:27 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+
+/*
+ * UTF-8 checked reading. The line is validated by the pass that looks for its
+ * newline (ft_memchr_utf8), so valid text is read once. After each read only
+ * the new bytes are checked, plus the start of a sequence cut by the previous
+ * read. Once an invalid byte is found, the rest of the line is only searched
+ * for the newline. Modes for invalid lines:
+ * - GNL_UTF8_REPORT: Returned as they are; info says where the error is.
+ * - GNL_UTF8_REPLACE: Each invalid sequence (its longest valid start, or one
+ *   byte) becomes U+FFFD, as the Unicode standard recommends.
+ * - GNL_UTF8_REJECT: Skipped, and counted in info->rejected.
+ */
+
+#define REPLACEMENT "\xEF\xBF\xBD"
+
+/**
+ * @brief Checks the bytes of the line read since the last call.
+ * @param gnl The reader.
+ * @param from In: where the unchecked bytes start. Out: where the next call
+ * starts (the start of a sequence cut by the end of the store, or the end).
+ * @param info The line's state, updated on the first invalid byte.
+ * @return The index of the newline, -1 if it is not read yet, or -2 if memory
+ * allocation fails.
+ */
+static ssize_t	check_new_bytes(t_gnl *gnl, size_t *from, t_gnl_utf8 *info)
+{
+	const char	*data;
+	size_t		len;
+	size_t		checked;
+	ssize_t		i_nl;
+	int			bad;
+
+	len = gnl_store_len(&gnl->store);
+	if (len <= *from)
+		return (-1);
+	i_nl = gnl_store_find(&gnl->store, *from, '\n');
+	if (!info->valid)
+		return (*from = len, i_nl);
+	data = gnl_store_data(&gnl->store);
+	if (!data)
+		return (-2);
+	i_nl = ft_memchr_utf8(data + *from, len - *from, &checked, &bad);
+	if (bad)
+		*info = (t_gnl_utf8){0, *from + checked, info->rejected};
+	if (i_nl >= 0)
+		return (*from + i_nl);
+	*from += checked;
+	if (bad)
+		*from = len;
+	return (-1);
+}
+
+/**
+ * @brief Reads until the next line is complete, checking it is UTF-8.
+ * @param gnl The reader.
+ * @param fd The file descriptor to read from.
+ * @param info Out: valid and error, for the line.
+ * @return The length of the line, newline included, the number of pending
+ * bytes at EOF (0 if none), or -1 on read error or memory allocation failure.
+ * @note A sequence cut by EOF is invalid.
+ */
+static ssize_t	utf8_line(t_gnl *gnl, int fd, t_gnl_utf8 *info)
+{
+	size_t	from;
+	ssize_t	i_nl;
+	ssize_t	bytes_read;
+
+	*info = (t_gnl_utf8){1, 0, info->rejected};
+	from = 0;
+	while (1)
+	{
+		i_nl = check_new_bytes(gnl, &from, info);
+		if (i_nl >= 0)
+			return (i_nl + 1);
+		bytes_read = -1;
+		if (i_nl == -1)
+			bytes_read = gnl_fill(gnl, fd);
+		if (bytes_read <= 0)
+			break ;
+	}
+	if (bytes_read == -1)
+		return (-1);
+	if (info->valid && from < gnl_store_len(&gnl->store))
+		*info = (t_gnl_utf8){0, from, info->rejected};
+	return (gnl_store_len(&gnl->store));
+}
+
+/**
+ * @brief Copies an invalid line, replacing each invalid sequence with U+FFFD.
+ * @param s The line.
+ * @param len The length of the line.
+ * @param error The offset of its first invalid byte: the bytes before it are
+ * copied as they are.
+ * @return The new string, or NULL if memory allocation fails.
+ */
+static char	*replace_invalid(const char *s, size_t len, size_t error)
+{
+	char	*line;
+	size_t	i;
+	size_t	j;
+	ssize_t	seq;
+
+	line = (char *)malloc((len * 3 + 1) * sizeof(char));
+	if (!line)
+		return (NULL);
+	ft_memcpy(line, s, error);
+	i = error;
+	j = error;
+	while (i < len)
+	{
+		seq = ft_utf8_len(s + i, len - i);
+		if (seq == 0)
+			seq = -(ssize_t)(len - i);
+		if (seq > 0)
+		{
+			ft_memcpy(line + j, s + i, seq);
+			j += seq;
+		}
+		else
+		{
+			ft_memcpy(line + j, REPLACEMENT, 3);
+			j += 3;
+			seq = -seq;
+		}
+		i += seq;
+	}
+	line[j] = '\0';
+	return (line);
+}
+
+/**
+ * @brief Reads a line from a file descriptor, checking that it is UTF-8.
+ * @param fd The file descriptor to read from.
+ * @param mode GNL_UTF8_REPORT, GNL_UTF8_REPLACE or GNL_UTF8_REJECT.
+ * @param info Zeroed before the first call. Out: whether the line was valid,
+ * where its first error was, and how many lines were rejected so far.
+ * @return
+ * - A null-terminated string containing the line read, newline included.
+ *
+ * - NULL on EOF, read error or memory allocation failure.
+ * @note As with get_next_line, the reader is cleared when NULL is returned.
+ * @warning The returned string must be freed by the caller.
+ */
+char	*gnl_next_utf8(int fd, int mode, t_gnl_utf8 *info)
+{
+	t_gnl	*gnl;
+	ssize_t	len;
+	char	*line;
+
+	gnl = gnl_get(fd);
+	if (!gnl || !info || BUFFER_SIZE <= 0)
+		return (NULL);
+	len = utf8_line(gnl, fd, info);
+	while (len > 0 && !info->valid && mode == GNL_UTF8_REJECT)
+	{
+		gnl_store_consume(&gnl->store, len);
+		info->rejected++;
+		len = utf8_line(gnl, fd, info);
+	}
+	if (len <= 0)
+		return (gnl_clear(gnl), NULL);
+	if (info->valid || mode != GNL_UTF8_REPLACE)
+		line = gnl_take(gnl, len);
+	else
+	{
+		line = NULL;
+		if (gnl_store_data(&gnl->store))
+			line = replace_invalid(gnl_store_data(&gnl->store), len,
+					info->error);
+		if (line)
+			gnl_store_consume(&gnl->store, len);
+	}
+	if (!line)
+		gnl_clear(gnl);
+	return (line);
+}
@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_utils.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:04:37 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/20 23:12:40 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+
+/**
+ * @brief Copies forward 8 bytes at a time. Each word is loaded before it is
+ * stored, so dest may overlap src as long as it starts before it.
+ */
+static void	copy_forward(unsigned char *d, const unsigned char *s, size_t n)
+{
+	uint64_t	word;
+
+	while (n >= 8)
+	{
+		__builtin_memcpy(&word, s, 8);
+		__builtin_memcpy(d, &word, 8);
+		d += 8;
+		s += 8;
+		n -= 8;
+	}
+	while (n--)
+		*d++ = *s++;
+}
+
+/**
+ * @brief Copies n bytes from src to dest, the areas may overlap.
+ * @param dest The destination memory area.
+ * @param src The source memory area.
+ * @param n The number of bytes to copy.
+ * @return A pointer to dest.
+ * @note Copies 8 bytes at a time, forward if dest starts before src, else
+ * backward: each word is loaded before it is stored.
+ */
+void	*ft_memmove(void *dest, const void *src, size_t n)
+{
+	unsigned char		*d;
+	const unsigned char	*s;
+	uint64_t			word;
+
+	d = (unsigned char *)dest;
+	s = (const unsigned char *)src;
+	if (d == s || n == 0)
+		return (dest);
+	if (d < s)
+		return (copy_forward(d, s, n), dest);
+	while (n >= 8)
+	{
+		n -= 8;
+		__builtin_memcpy(&word, s + n, 8);
+		__builtin_memcpy(d + n, &word, 8);
+	}
+	while (n--)
+		d[n] = s[n];
+	return (dest);
+}
+
+/**
+ * @brief Scans memory backwards for the last occurrence of a byte.
+ * @param s The memory area to scan.
+ * @param c The byte to find (interpreted as unsigned char).
+ * @param n The number of bytes to scan.
+ * @return A pointer to the matching byte, or NULL if it is not in the area.
+ */
+void	*ft_memrchr(const void *s, int c, size_t n)
+{
+	const unsigned char	*p;
+
+	p = (const unsigned char *)s + n;
+	while (n--)
+	{
+		if (*--p == (unsigned char)c)
+			return ((void *)p);
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Compares two memory areas.
+ * @param s1 The first memory area.
+ * @param s2 The second memory area.
+ * @param n The number of bytes to compare.
+ * @return The difference between the first differing bytes (as unsigned
+ * char), or 0 if the areas are equal.
+ */
+int	ft_memcmp(const void *s1, const void *s2, size_t n)
+{
+	const unsigned char	*p1;
+	const unsigned char	*p2;
+
+	p1 = (const unsigned char *)s1;
+	p2 = (const unsigned char *)s2;
+	while (n--)
+	{
+		if (*p1 != *p2)
+			return (*p1 - *p2);
+		p1++;
+		p2++;
+	}
+	return (0);
+}
+
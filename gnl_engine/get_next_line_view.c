@@ -0,0 +1,48 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   get_next_line_view.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 02:44:12 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/21 17:08:56 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "get_next_line.h"
+#include <errno.h>
+
+/**
+ * @brief Returns the next line as a view into the reader's buffer, without
+ * allocating or copying it.
+ * @param fd The file descriptor (or source, see gnl_open_source).
+ * @param len Set to the length of the line, newline included.
+ * @return A pointer to the line, NOT null-terminated, valid until the next
+ * call on fd; NULL with errno 0 at EOF, NULL with errno set on error.
+ * @note errno is set to 0 at EOF because the probes of a read (fstat, ioctl,
+ * readahead...) may fail harmlessly and leave it set.
+ * @note With the list and ring storages, a line spread over several chunks or
+ * wrapping around the ring is made contiguous first.
+ */
+const char	*gnl_next_view(int fd, size_t *len)
+{
+	t_gnl	*gnl;
+	ssize_t	n;
+	char	*line;
+
+	gnl = gnl_get(fd);
+	if (!gnl || !len || BUFFER_SIZE <= 0)
+		return (NULL);
+	n = gnl_line_len(gnl, fd);
+	line = NULL;
+	if (n > 0)
+		line = gnl_store_data(&gnl->store);
+	if (!line && !n)
+		return (gnl_clear(gnl), errno = 0, NULL);
+	if (!line)
+		return (gnl_clear(gnl), NULL);
+	gnl->held = n;
+	*len = n;
+	return (line);
+}
@@ -6,7 +6,7 @@
 /*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/12/28 16:14:30 by ozamora-          #+#    #+#             */
-/*   Updated: 2025/04/15 02:18:41 by ozamora-         ###   ########.fr       */
+/*   Updated: 2026/10/19 18:31:44 by ozamora-         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -123,25 +123,32 @@ static char	*extract_line_store_remaining(char *line_buffer)
  * @note The function uses a static variable to handle multi-line reads across
  * multiple calls. It reads from the file descriptor in chunks of BUFFER_SIZE 
  * and processes the data until a newline character or EOF is encountered.
+ * @note The read buffer is kept in the extra slot store[MAX_FD], shared by
+ * every fd: allocated on the first read, freed at EOF or error. No read is done
+ * while the store already holds a full line.
  * @note Depends on Libft functions: `ft_strdup`, `ft_strchr`, `ft_substr`,
  * `ft_strjoin`, and `ft_strlen`.
  * @warning The returned string must be freed by the caller.
  */
 char	*get_next_line(int fd)
 {
-	static char	*store[MAX_FD];
+	static char	*store[MAX_FD + 1];
 	char		*line;
-	char		*buffer;
 
-	if (fd < 0 || BUFFER_SIZE <= 0 || fd >= MAX_FD)
-		return (free(store[fd]), store[fd] = NULL, NULL);
-	buffer = (char *)malloc((BUFFER_SIZE + 1) * sizeof(char));
-	if (!buffer)
-		return (free(store[fd]), store[fd] = NULL, NULL);
-	line = read_and_append(fd, store[fd], buffer);
-	(free(buffer), buffer = NULL);
+	if (fd < 0 || fd >= MAX_FD || BUFFER_SIZE <= 0)
+		return (NULL);
+	line = store[fd];
+	if (!line || !ft_strchr(line, '\n'))
+	{
+		if (!store[MAX_FD])
+			store[MAX_FD] = (char *)malloc((BUFFER_SIZE + 1) * sizeof(char));
+		if (!store[MAX_FD])
+			return (free(store[fd]), store[fd] = NULL, NULL);
+		line = read_and_append(fd, store[fd], store[MAX_FD]);
+	}
 	if (!line)
-		return (free(store[fd]), store[fd] = NULL, NULL);
+		return (free(store[fd]), store[fd] = NULL,
+			free(store[MAX_FD]), store[MAX_FD] = NULL, NULL);
 	store[fd] = extract_line_store_remaining(line);
 	return (line);
 }
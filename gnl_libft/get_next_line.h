@@ -6,7 +6,7 @@
 /*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/12/28 16:27:13 by ozamora-          #+#    #+#             */
-/*   Updated: 2025/04/15 02:13:56 by ozamora-         ###   ########.fr       */
+/*   Updated: 2026/10/21 12:03:15 by ozamora-         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -21,6 +21,11 @@
 #  define BUFFER_SIZE 42
 # endif
 
+/* Word-at-a-time scanning: a long has a zero byte when
+ * (word - GNL_ONES) & ~word & GNL_HIGHS is not zero. */
+# define GNL_ONES (~0UL / 0xFF)
+# define GNL_HIGHS (GNL_ONES << 7)
+
 /* ************************************************************************** */
 
 # include "libft.h"
@@ -6,7 +6,7 @@
 /*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/10/15 20:35:18 by ozamora-          #+#    #+#             */
-/*   Updated: 2024/11/13 15:34:15 by ozamora-         ###   ########.fr       */
+/*   Updated: 2026/10/19 18:31:44 by ozamora-         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -139,33 +139,40 @@ void	process_line(int i_nl, t_list **line, char **line_str)
  * Return: 
  *  - No return value.
  * Description:
- *  - Allocates a buffer and reads from the fd in a loop.
- *  - Stores the read data in the list until a newline is found or EOF is 
- *    reached.
- *  - Frees the buffer after reading.
+ *  - Does not read at all if the list already holds a newline.
+ *  - Reads from the fd straight into new list nodes, so no intermediate
+ *    buffer is allocated and copied on each call.
+ *  - Stops at the first node containing a newline, or at EOF.
  */
 void	read_and_store(int fd, t_list **line)
 {
 	int		bytes_read;
-	char	*buffer;
+	t_list	*node;
+	t_list	*last;
 
-	if (fd < 0 || !line || BUFFER_SIZE <= 0)
-		return ;
-	buffer = (char *)malloc((BUFFER_SIZE + 1) * sizeof(char));
-	if (!buffer)
+	if (fd < 0 || !line || BUFFER_SIZE <= 0 || ft_lst_hasnextline(line) >= 0)
 		return ;
+	last = ft_lstlast(*line);
 	bytes_read = 1;
-	while (bytes_read != 0 && (ft_lst_hasnextline(line) < 0))
+	while (bytes_read > 0 && ft_lst_hasnextline(&last) < 0)
 	{
-		bytes_read = read(fd, buffer, BUFFER_SIZE);
-		if (bytes_read == 0)
-			return (free(buffer));
+		node = ft_lst_newbuf(BUFFER_SIZE);
+		if (!node)
+			return (ft_lstclear(line, free));
+		bytes_read = read(fd, node->content, BUFFER_SIZE);
+		if (bytes_read <= 0)
+			(free(node->content), free(node));
 		if (bytes_read == -1)
-			return (ft_lstclear(line, free), line = NULL, free(buffer));
-		buffer[bytes_read] = '\0';
-		ft_lst_new_addback(buffer, line, bytes_read);
+			return (ft_lstclear(line, free));
+		if (bytes_read == 0)
+			return ;
+		((char *)node->content)[bytes_read] = '\0';
+		if (!last)
+			*line = node;
+		else
+			last->next = node;
+		last = node;
 	}
-	free(buffer);
 }
 
 /**
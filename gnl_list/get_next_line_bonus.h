@@ -6,7 +6,7 @@
 /*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/10/15 20:35:15 by ozamora-          #+#    #+#             */
-/*   Updated: 2024/11/13 15:35:49 by ozamora-         ###   ########.fr       */
+/*   Updated: 2026/10/19 18:31:44 by ozamora-         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -51,6 +51,7 @@ typedef struct s_list
  * 
  * List Handling Functions:
  * - ft_lst_hasnextline: Checks if the line contains a newline, returns where. 
+ * - ft_lst_newbuf: Creates a node with an empty buffer for read to fill.
  * - ft_lst_new_addback: Adds a new element with content to the end of the list.
  *                       Combination of lst_add and lst_addback from Libft
  * - ft_lstlast: Returns the last element of the list.
@@ -64,6 +65,7 @@ typedef struct s_list
 char	*get_next_line(int fd);
 
 int		ft_lst_hasnextline(t_list **lst);
+t_list	*ft_lst_newbuf(int size);
 void	ft_lst_new_addback(void *content, t_list **lst, int bytes_read);
 t_list	*ft_lstlast(t_list *lst);
 void	ft_lstclear(t_list **lst, void (*del)(void *));
@@ -6,13 +6,14 @@
 /*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/10/02 17:19:07 by ozamora-          #+#    #+#             */
-/*   Updated: 2025/01/07 17:18:06 by ozamora-         ###   ########.fr       */
+/*   Updated: 2026/10/20 23:12:40 by ozamora-         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "get_next_line.h"
 
 int		ft_lst_hasnextline(t_list **lst);
+t_list	*ft_lst_newbuf(int size);
 void	ft_lst_new_addback(void *content, t_list **lst, int bytes_read);
 t_list	*ft_lstlast(t_list *lst);
 void	ft_lstclear(t_list **lst, void (*del)(void *));
@@ -54,6 +55,29 @@ int	ft_lst_hasnextline(t_list **lst)
 	return (-1);
 }
 
+/**
+ * ft_lst_newbuf - Creates a list node with an empty buffer to read into.
+ * @param size: The most bytes the buffer will hold, plus one for the '\0'.
+ * 
+ * Return: 
+ *  - The new node, not linked to any list.
+ *  - NULL if memory allocation fails.
+ */
+t_list	*ft_lst_newbuf(int size)
+{
+	t_list	*new;
+
+	new = (t_list *)malloc(sizeof(t_list));
+	if (!new)
+		return (NULL);
+	new->next = NULL;
+	new->content = (char *)malloc((size + 1) * sizeof(char));
+	if (!new->content)
+		return (free(new), NULL);
+	((char *)new->content)[0] = '\0';
+	return (new);
+}
+
 /* ************************************************************************** */
 /*                        Functions from ozamora-'s Libft
  * 
@@ -115,12 +139,12 @@ void	ft_lstclear(t_list **lst, void (*del)(void *))
 
 size_t	ft_strlen(const char *s)
 {
-	int	len;
+	size_t	len;
 
 	len = 0;
 	while (s[len] != '\0')
 		len++;
-	return ((size_t)len);
+	return (len);
 }
 
 t_list	*ft_lstlast(t_list *lst)
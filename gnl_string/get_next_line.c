@@ -6,7 +6,7 @@
 /*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/10/15 20:35:18 by ozamora-          #+#    #+#             */
-/*   Updated: 2025/02/10 23:20:36 by ozamora-         ###   ########.fr       */
+/*   Updated: 2026/10/19 18:31:44 by ozamora-         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -81,6 +81,8 @@ static char	*get_line(char *line_buffer)
  * @note The function uses a static variable to handle multi-line reads across
  * multiple calls. It reads from the file descriptor in chunks of BUFFER_SIZE 
  * and processes the data until a newline character or EOF is encountered.
+ * @note The read buffer is allocated on the first read and kept until EOF or
+ * error, and no read is done while the store already holds a full line.
  * @note Depends on Libft functions: `ft_strdup`, `ft_strchr`, `ft_substr`,
  * `ft_strjoin`, and `ft_strlen`.
  * @warning The returned string must be freed by the caller.
@@ -88,18 +90,22 @@ static char	*get_line(char *line_buffer)
 char	*get_next_line(int fd)
 {
 	static char	*store = NULL;
+	static char	*buffer = NULL;
 	char		*line;
-	char		*buffer;
 
 	if (fd < 0 || BUFFER_SIZE <= 0)
-		return (free(store), store = NULL, NULL);
-	buffer = (char *)malloc((BUFFER_SIZE + 1) * sizeof(char));
-	if (!buffer)
-		return (free(store), store = NULL, NULL);
-	line = read_and_store(fd, store, buffer);
-	(free(buffer), buffer = NULL);
+		return (free(store), store = NULL, free(buffer), buffer = NULL, NULL);
+	line = store;
+	if (!line || !ft_strchr(line, '\n'))
+	{
+		if (!buffer)
+			buffer = (char *)malloc((BUFFER_SIZE + 1) * sizeof(char));
+		if (!buffer)
+			return (free(store), store = NULL, NULL);
+		line = read_and_store(fd, store, buffer);
+	}
 	if (!line)
-		return (free(store), store = NULL, NULL);
+		return (free(store), store = NULL, free(buffer), buffer = NULL, NULL);
 	store = get_line(line);
 	return (line);
 }
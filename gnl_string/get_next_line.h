@@ -6,7 +6,7 @@
 /*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/10/15 20:35:15 by ozamora-          #+#    #+#             */
-/*   Updated: 2024/12/28 19:23:20 by ozamora-         ###   ########.fr       */
+/*   Updated: 2026/10/21 12:03:15 by ozamora-         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -19,6 +19,11 @@
 #  define BUFFER_SIZE 42
 # endif
 
+/* Word-at-a-time scanning: a long has a zero byte when
+ * (word - GNL_ONES) & ~word & GNL_HIGHS is not zero. */
+# define GNL_ONES (~0UL / 0xFF)
+# define GNL_HIGHS (GNL_ONES << 7)
+
 /* ************************************************************************** */
 
 # include <fcntl.h>  // For file control options and constants like O_RDONLY
@@ -6,7 +6,7 @@
 /*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/10/15 20:35:11 by ozamora-          #+#    #+#             */
-/*   Updated: 2024/12/28 19:34:58 by ozamora-         ###   ########.fr       */
+/*   Updated: 2026/10/21 12:03:15 by ozamora-         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -40,7 +40,7 @@ char	*ft_strdup(const char *s)
 	if (!dup)
 		return (NULL);
 	i = 0;
-	while (s[i] != '\0' && i < s_len)
+	while (i < s_len)
 	{
 		dup[i] = s[i];
 		i++;
@@ -60,19 +60,41 @@ char	*ft_strdup(const char *s)
  * 
  * Edge cases checked:
  * - Handles NULL string input.
+ *
+ * Note: Once aligned it tests a whole long per step for either 'c' or '\0',
+ * loaded with __builtin_memcpy so that chars are not read through a long
+ * pointer. Those aligned reads never cross into the next page, but may pass
+ * the '\0' into bytes ASan sees as unallocated, hence the ASan opt-out.
  */
+__attribute__((no_sanitize_address))
 char	*ft_strchr(const char *s, int c)
 {
+	unsigned long	word;
+	unsigned long	hit;
+
 	if (!s)
 		return (NULL);
-	while (1)
+	while ((unsigned long)s % sizeof(unsigned long) != 0)
 	{
 		if (*s == (char)c)
 			return ((char *)s);
 		if (*s == '\0')
-			break ;
+			return (NULL);
 		s++;
 	}
+	while (1)
+	{
+		__builtin_memcpy(&word, s, sizeof(word));
+		hit = word ^ (GNL_ONES * (unsigned char)c);
+		if ((((word - GNL_ONES) & ~word) | ((hit - GNL_ONES) & ~hit))
+			& GNL_HIGHS)
+			break ;
+		s += sizeof(word);
+	}
+	while (*s != (char)c && *s != '\0')
+		s++;
+	if (*s == (char)c)
+		return ((char *)s);
 	return (NULL);
 }
 
@@ -92,9 +114,9 @@ char	*ft_strchr(const char *s, int c)
 char	*ft_strjoin(char const *s1, char const *s2)
 {
 	char	*joined;
-	int		s1_len;
-	int		s2_len;
-	int		i;
+	size_t	s1_len;
+	size_t	s2_len;
+	size_t	i;
 
 	s1_len = ft_strlen(s1);
 	s2_len = ft_strlen(s2);
@@ -123,15 +145,18 @@ char	*ft_strjoin(char const *s1, char const *s2)
  * @s: The string to measure.
  * 
  * Return: The length of the string.
+ *
+ * Note: Kept as a plain loop: optimizing compilers recognize it and call the
+ * libc strlen, which beats any word loop written here.
  */
 size_t	ft_strlen(const char *s)
 {
-	int	len;
+	size_t	len;
 
 	len = 0;
 	while (s[len] != '\0')
 		len++;
-	return ((size_t)len);
+	return (len);
 }
 
 /**
@@ -166,13 +191,10 @@ char	*ft_substr(char const *s, unsigned int start, size_t len)
 	if (!subs)
 		return (NULL);
 	i = 0;
-	if (start < s_len)
+	while (i < len)
 	{
-		while (s[start + i] != '\0' && i < len)
-		{
-			subs[i] = s[start + i];
-			i++;
-		}
+		subs[i] = s[start + i];
+		i++;
 	}
 	subs[i] = '\0';
 	return (subs);
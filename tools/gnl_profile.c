@@ -0,0 +1,959 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   gnl_profile.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ozamora- <ozamora-@student.42madrid.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 06:12:37 by ozamora-          #+#    #+#             */
+/*   Updated: 2026/10/20 06:12:37 by ozamora-         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+ * gnl_profile: samples a file or stream and recommends a reader configuration
+ * (GNL_STORAGE and BUFFER_SIZE) for the gnl_engine, from measurements instead
+ * of folklore. Standalone, it does not link the engine:
+ *
+ *	cc -O2 -Wall -Wextra -Werror tools/gnl_profile.c -o gnl_profile
+ *	./gnl_profile [-s MiB] [file]	(standard input without a file)
+ *
+ * 1. The sample (64 MiB by default) is read with reads of 1 MiB, recording the
+ *    size each read returned (for a pipe or socket: how the data arrives) and
+ *    the length of every line.
+ * 2. The cost of a syscall, of copying a byte and of a malloc and free pair
+ *    are timed on this machine, and so is the cost per byte of reading the
+ *    sample (from the page cache, or from a temporary copy for a stream) and
+ *    scanning it for newlines through a buffer of each size: past the size of
+ *    the caches, the bytes are evicted before they are looked at.
+ * 3. For every power of two read size, the reads, the bytes the store moves
+ *    or copies on its own, the allocations and the peak memory of each
+ *    storage are counted by replaying its growth rules on the sampled lines
+ *    (get_next_line, and the view readers: gnl_next_view, gnl_for_each_line).
+ *    Their cost is estimated from the measurements, the bytes read being
+ *    charged at the cost per byte of a buffer of the storage's peak memory.
+ *    Copying the lines out is the same for every configuration: left out.
+ * 4. The recommendation is the configuration with the lowest peak memory among
+ *    those whose estimated cost is within 10% of the cheapest.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define READ_SIZE 1048576
+#define SIZE_MIN 64
+#define SIZES 15 // 64 B to 1 MiB
+#define MEASURES 17 // 64 B to 4 MiB
+#define MEASURE_BYTES 16777216
+#define ENGINES 3
+#define TOLERANCE 1.10
+
+/*
+ * The sample:
+ * - lines: Length of each line, newline included (the last may have none).
+ * - reads: Number of bytes returned by each read of READ_SIZE.
+ * - kept: The first MEASURE_BYTES bytes of a stream, to time reads with.
+ */
+typedef struct s_sample
+{
+	uint32_t	*lines;
+	size_t		n_lines;
+	uint32_t	*reads;
+	size_t		n_reads;
+	size_t		bytes;
+	int			regular;
+	char		*kept;
+	size_t		n_kept;
+}	t_sample;
+
+/*
+ * The bytes as the engine gets them: a read returns at most what the current
+ * arrival (a read of the sample) has left.
+ */
+typedef struct s_feed
+{
+	const t_sample	*s;
+	size_t			i;
+	size_t			left;
+}	t_feed;
+
+/*
+ * What one storage did with one read size.
+ */
+typedef struct s_sim
+{
+	size_t	reads;
+	size_t	allocs;
+	size_t	copied;
+	size_t	peak;
+	double	cost;
+}	t_sim;
+
+/*
+ * Measured costs, in nanoseconds.
+ * - syscall, byte, alloc: A syscall, copying a byte, a malloc and free pair.
+ * - read: Reading and scanning a byte through a buffer of 64 B << index.
+ */
+typedef struct s_costs
+{
+	double	syscall;
+	double	byte;
+	double	alloc;
+	double	read[MEASURES];
+}	t_costs;
+
+/*
+ * Models of the storages: only sizes, no bytes.
+ * - t_buf: The contiguous buffer, pending bytes in [start, end).
+ * - t_ring: The ring, pending bytes from head, wrapping around cap.
+ * - t_list: The chunk list, chunks[head] to chunks[tail - 1] in the list
+ *   (slots is the size of the array); spare is the capacity of the spare chunk
+ *   (0 for none) and mem the capacity of every chunk held.
+ */
+typedef struct s_buf
+{
+	size_t	start;
+	size_t	end;
+	size_t	cap;
+}	t_buf;
+
+typedef struct s_ring
+{
+	size_t	head;
+	size_t	len;
+	size_t	cap;
+}	t_ring;
+
+typedef struct s_chunk
+{
+	size_t	cap;
+	size_t	len;
+}	t_chunk;
+
+typedef struct s_list
+{
+	t_chunk	*chunks;
+	size_t	head;
+	size_t	tail;
+	size_t	slots;
+	size_t	off;
+	size_t	len;
+	size_t	spare;
+	size_t	mem;
+}	t_list;
+
+static const char	*g_engines[ENGINES] = {"list", "buf", "ring"};
+static const char	*g_macros[ENGINES] = {"GNL_STORAGE_LIST", "GNL_STORAGE_BUF",
+	"GNL_STORAGE_RING"};
+
+/* ************************************************************************** */
+/* Sampling                                                                   */
+/* ************************************************************************** */
+
+static int	push(uint32_t **v, size_t *n, uint32_t value)
+{
+	uint32_t	*bigger;
+
+	if (!(*n & (*n - 1)) && *n >= 1024)
+	{
+		bigger = realloc(*v, *n * 2 * sizeof(uint32_t));
+		if (!bigger)
+			return (-1);
+		*v = bigger;
+	}
+	else if (!*v)
+	{
+		*v = malloc(1024 * sizeof(uint32_t));
+		if (!*v)
+			return (-1);
+	}
+	(*v)[(*n)++] = value;
+	return (0);
+}
+
+/**
+ * @brief Records the lines of one read; `open` carries the length of the line
+ * still open at the end of the previous read.
+ */
+static int	scan(t_sample *s, const char *buf, size_t n, size_t *open)
+{
+	const char	*nl;
+	const char	*end;
+
+	end = buf + n;
+	while (buf < end)
+	{
+		nl = memchr(buf, '\n', end - buf);
+		if (!nl)
+		{
+			*open += end - buf;
+			return (0);
+		}
+		if (push(&s->lines, &s->n_lines, *open + (nl + 1 - buf)) == -1)
+			return (-1);
+		*open = 0;
+		buf = nl + 1;
+	}
+	return (0);
+}
+
+/**
+ * @brief Keeps the first MEASURE_BYTES bytes of a stream, which cannot be read
+ * again.
+ */
+static int	keep(t_sample *s, const char *buf, size_t n)
+{
+	if (s->regular || s->n_kept == MEASURE_BYTES)
+		return (0);
+	if (!s->kept)
+		s->kept = malloc(MEASURE_BYTES);
+	if (!s->kept)
+		return (-1);
+	if (n > MEASURE_BYTES - s->n_kept)
+		n = MEASURE_BYTES - s->n_kept;
+	memcpy(s->kept + s->n_kept, buf, n);
+	s->n_kept += n;
+	return (0);
+}
+
+/**
+ * @brief Reads up to `limit` bytes of fd with reads of READ_SIZE.
+ * @return 0, or -1 on read or allocation error.
+ */
+static int	sample(int fd, size_t limit, t_sample *s)
+{
+	char		*buf;
+	ssize_t		n;
+	size_t		open;
+	struct stat	sb;
+
+	buf = malloc(READ_SIZE);
+	if (!buf)
+		return (-1);
+	s->regular = (fstat(fd, &sb) == 0 && S_ISREG(sb.st_mode));
+	open = 0;
+	n = 1;
+	while (s->bytes < limit && n > 0)
+	{
+		n = read(fd, buf, READ_SIZE);
+		if (n > 0 && (push(&s->reads, &s->n_reads, n) == -1
+				|| scan(s, buf, n, &open) == -1 || keep(s, buf, n) == -1))
+			n = -1;
+		s->bytes += (n > 0) * n;
+	}
+	free(buf);
+	if (n >= 0 && open)
+		return (push(&s->lines, &s->n_lines, open));
+	return (-(n < 0));
+}
+
+/* ************************************************************************** */
+/* Measurements                                                               */
+/* ************************************************************************** */
+
+static double	now_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+/**
+ * @brief Times reading `bytes` bytes of fd from offset 0 with reads of `size`
+ * bytes, each scanned for newlines as the engine would.
+ * @return The cost per byte, the syscalls left out.
+ */
+static double	time_reads(int fd, size_t bytes, size_t size, double syscall)
+{
+	static char	buf[READ_SIZE << 2];
+	const char	*nl;
+	size_t		off;
+	ssize_t		n;
+	double		t;
+
+	off = 0;
+	n = 1;
+	t = now_ns();
+	while (off < bytes && n > 0)
+	{
+		n = pread(fd, buf, size, off);
+		nl = buf;
+		while (n > 0 && nl < buf + n)
+		{
+			nl = memchr(nl, '\n', buf + n - nl);
+			if (!nl)
+				break ;
+			nl++;
+		}
+		off += (n > 0) * n;
+	}
+	t = now_ns() - t - (double)(off + size - 1) / size * syscall;
+	return ((t > 0) * t / (off + !off));
+}
+
+/**
+ * @brief Times each read size on fd, or on a temporary file holding the start
+ * of a stream, from the page cache (a first pass warms it up).
+ */
+static void	measure_reads(int fd, const t_sample *s, t_costs *c)
+{
+	FILE	*tmp;
+	size_t	bytes;
+	int		k;
+
+	tmp = NULL;
+	bytes = s->bytes;
+	if (!s->regular)
+	{
+		tmp = tmpfile();
+		bytes = 0;
+		if (tmp && write(fileno(tmp), s->kept, s->n_kept) == (ssize_t)s->n_kept)
+			bytes = s->n_kept;
+		if (tmp)
+			fd = fileno(tmp);
+	}
+	if (bytes > MEASURE_BYTES)
+		bytes = MEASURE_BYTES;
+	time_reads(fd, bytes, READ_SIZE, c->syscall);
+	k = -1;
+	while (++k < MEASURES)
+		c->read[k] = time_reads(fd, bytes, SIZE_MIN << k, c->syscall);
+	if (tmp)
+		fclose(tmp);
+}
+
+/**
+ * @brief Times an empty read of fd (the syscall alone), a copy between two
+ * 1 MiB buffers, a malloc and free pair of 4 KiB, and each read size.
+ */
+static void	measure(int fd, const t_sample *s, t_costs *c)
+{
+	static char		a[READ_SIZE * 2];
+	void *volatile	p;
+	double			t;
+	int				i;
+
+	t = now_ns();
+	i = -1;
+	while (++i < 20000)
+		if (read(fd, a, 0) < 0)
+			break ;
+	c->syscall = (now_ns() - t) / 20000;
+	memset(a, 'x', sizeof(a));
+	t = now_ns();
+	i = -1;
+	while (++i < 64)
+		memcpy(a + (i & 1) * READ_SIZE, a + !(i & 1) * READ_SIZE, READ_SIZE);
+	c->byte = (now_ns() - t) / (64.0 * READ_SIZE);
+	t = now_ns();
+	i = -1;
+	while (++i < 100000)
+	{
+		p = malloc(4096);
+		free(p);
+	}
+	c->alloc = (now_ns() - t) / 100000;
+	measure_reads(fd, s, c);
+}
+
+/* ************************************************************************** */
+/* Storage models, mirroring gnl_engine/get_next_line_store_*.c               */
+/* ************************************************************************** */
+
+static size_t	feed(t_feed *f, size_t room)
+{
+	size_t	n;
+
+	while (!f->left && f->i < f->s->n_reads)
+		f->left = f->s->reads[f->i++];
+	n = room;
+	if (n > f->left)
+		n = f->left;
+	f->left -= n;
+	return (n);
+}
+
+static void	note_peak(t_sim *r, size_t mem)
+{
+	if (mem > r->peak)
+		r->peak = mem;
+}
+
+/**
+ * @brief gnl_store_reserve of the contiguous buffer: the pending bytes are
+ * moved to the front if that makes room, else the buffer is (at least)
+ * doubled.
+ */
+static void	buf_reserve(t_buf *b, size_t size, t_sim *r)
+{
+	size_t	len;
+
+	len = b->end - b->start;
+	if (b->cap - b->end < size && b->start && b->cap - len >= size)
+	{
+		r->copied += len;
+		*b = (t_buf){0, len, b->cap};
+	}
+	if (b->cap - b->end < size)
+	{
+		r->copied += len;
+		r->allocs++;
+		*b = (t_buf){0, len, b->cap * 2};
+		if (b->cap < len + size)
+			b->cap = len + size;
+		note_peak(r, b->cap);
+	}
+}
+
+/**
+ * @brief Replays the contiguous buffer. Views cost nothing more: the pending
+ * bytes are always contiguous.
+ */
+static void	sim_buf(const t_sample *s, size_t size, int views, t_sim *r)
+{
+	t_feed	f;
+	t_buf	b;
+	size_t	i;
+	size_t	n;
+
+	(void)views;
+	f = (t_feed){s, 0, 0};
+	b = (t_buf){0, 0, 0};
+	i = -1;
+	while (++i < s->n_lines)
+	{
+		n = 1;
+		while (b.end - b.start < s->lines[i] && n)
+		{
+			buf_reserve(&b, size, r);
+			n = feed(&f, b.cap - b.end);
+			b.end += n;
+			r->reads++;
+		}
+		b.start += s->lines[i];
+		if (b.start == b.end)
+			b = (t_buf){0, 0, b.cap};
+	}
+}
+
+/**
+ * @brief grow_ring: the ring is reallocated to the smallest power of two
+ * holding the pending bytes plus a read, and at least doubled.
+ */
+static void	ring_reserve(t_ring *g, size_t size, t_sim *r)
+{
+	size_t	cap;
+
+	if (g->cap - g->len >= size)
+		return ;
+	cap = 1;
+	while (cap < g->len + size || cap < g->cap * 2)
+		cap *= 2;
+	r->copied += g->len;
+	r->allocs++;
+	*g = (t_ring){0, g->len, cap};
+	note_peak(r, cap);
+}
+
+/**
+ * @brief Replays the ring. A view of pending bytes wrapping around the end
+ * unwraps them into a new ring first.
+ */
+static void	sim_ring(const t_sample *s, size_t size, int views, t_sim *r)
+{
+	t_feed	f;
+	t_ring	g;
+	size_t	i;
+	size_t	n;
+
+	f = (t_feed){s, 0, 0};
+	g = (t_ring){0, 0, 0};
+	i = -1;
+	while (++i < s->n_lines)
+	{
+		n = 1;
+		while (g.len < s->lines[i] && n)
+		{
+			ring_reserve(&g, size, r);
+			n = feed(&f, g.cap - g.len);
+			g.len += n;
+			r->reads++;
+		}
+		if (views && g.head + g.len > g.cap)
+		{
+			r->copied += g.len;
+			r->allocs++;
+			g.head = 0;
+		}
+		g.head = (g.head + s->lines[i]) & (g.cap - 1);
+		g.len -= s->lines[i];
+		if (!g.len)
+			g.head = 0;
+	}
+}
+
+/**
+ * @brief take_chunk: the spare chunk if it is big enough, else a new one (the
+ * spare is then freed).
+ * @return The capacity of the chunk.
+ */
+static size_t	take_chunk(t_list *l, size_t size, t_sim *r)
+{
+	size_t	cap;
+
+	cap = l->spare;
+	l->spare = 0;
+	if (cap >= size)
+		return (cap);
+	l->mem += size - cap;
+	r->allocs++;
+	note_peak(r, l->mem);
+	return (size);
+}
+
+/**
+ * @brief Appends a chunk to the list, compacting or growing the array.
+ * @return 0, or -1 if memory allocation fails.
+ */
+static int	append_chunk(t_list *l, size_t cap, size_t len)
+{
+	t_chunk	*bigger;
+
+	if (l->tail == l->slots && l->head >= l->slots / 2 && l->head)
+	{
+		memmove(l->chunks, l->chunks + l->head,
+			(l->tail - l->head) * sizeof(t_chunk));
+		l->tail -= l->head;
+		l->head = 0;
+	}
+	if (l->tail == l->slots)
+	{
+		bigger = realloc(l->chunks, (l->slots * 2 + 16) * sizeof(t_chunk));
+		if (!bigger)
+			return (-1);
+		l->chunks = bigger;
+		l->slots = l->slots * 2 + 16;
+	}
+	l->chunks[l->tail++] = (t_chunk){cap, len};
+	l->len += len;
+	return (0);
+}
+
+/**
+ * @brief gnl_store_reserve_iov, the read and gnl_store_commit: the free end of
+ * the last chunk and the spare chunk are filled by one read.
+ * @return The number of bytes read, or -1 if memory allocation fails.
+ */
+static ssize_t	list_fill(t_list *l, t_feed *f, size_t size, t_sim *r)
+{
+	t_chunk	*t;
+	size_t	left;
+	size_t	n;
+
+	left = 0;
+	if (l->tail > l->head)
+		left = l->chunks[l->tail - 1].cap - l->chunks[l->tail - 1].len;
+	if (left && left < size)
+	{
+		if (l->spare < size - left)
+			l->spare = take_chunk(l, size - left, r);
+		n = feed(f, left + l->spare);
+		if (n < left)
+			left = n;
+		l->chunks[l->tail - 1].len += left;
+		l->len += left;
+		if (n > left && append_chunk(l, l->spare, n - left) == -1)
+			return (-1);
+		if (n > left)
+			l->spare = 0;
+		return (n);
+	}
+	if (!left && append_chunk(l, take_chunk(l, size, r), 0) == -1)
+		return (-1);
+	t = &l->chunks[l->tail - 1];
+	n = feed(f, t->cap - t->len);
+	t->len += n;
+	l->len += n;
+	return (n);
+}
+
+/**
+ * @brief gnl_store_consume: consumed chunks are freed but for one kept as the
+ * spare, and the last chunk is reused once empty.
+ */
+static void	list_consume(t_list *l, size_t n)
+{
+	l->len -= n;
+	n += l->off;
+	while (l->tail - l->head > 1 && n >= l->chunks[l->head].len)
+	{
+		n -= l->chunks[l->head].len;
+		if (l->spare)
+			l->mem -= l->chunks[l->head].cap;
+		else
+			l->spare = l->chunks[l->head].cap;
+		l->head++;
+	}
+	l->off = n;
+	if (l->off == l->chunks[l->head].len)
+	{
+		l->chunks[l->head].len = 0;
+		l->off = 0;
+	}
+}
+
+/**
+ * @brief gnl_store_data: pending bytes spread over several chunks are merged
+ * into a new one, and the old chunks freed.
+ */
+static void	list_merge(t_list *l, t_sim *r)
+{
+	size_t	cap;
+
+	if (l->off + l->len <= l->chunks[l->head].len)
+		return ;
+	cap = l->chunks[l->tail - 1].cap;
+	if (cap < l->len)
+		cap = l->len;
+	r->copied += l->len;
+	r->allocs++;
+	note_peak(r, l->mem + cap);
+	l->mem = cap + l->spare;
+	l->chunks[0] = (t_chunk){cap, l->len};
+	l->head = 0;
+	l->tail = 1;
+	l->off = 0;
+}
+
+/**
+ * @brief Replays the chunk list. A view of a line spread over several chunks
+ * merges them first.
+ * @return 0, or -1 if memory allocation fails.
+ */
+static int	sim_list(const t_sample *s, size_t size, int views, t_sim *r)
+{
+	t_feed	f;
+	t_list	l;
+	size_t	i;
+	ssize_t	n;
+
+	f = (t_feed){s, 0, 0};
+	l = (t_list){NULL, 0, 0, 0, 0, 0, 0, 0};
+	i = -1;
+	while (++i < s->n_lines)
+	{
+		n = 1;
+		while (l.len < s->lines[i] && n > 0)
+		{
+			n = list_fill(&l, &f, size, r);
+			r->reads++;
+		}
+		if (n == -1)
+			return (free(l.chunks), -1);
+		if (views)
+			list_merge(&l, r);
+		list_consume(&l, s->lines[i]);
+	}
+	free(l.chunks);
+	return (0);
+}
+
+/* ************************************************************************** */
+/* Report                                                                     */
+/* ************************************************************************** */
+
+static const char	*human(size_t n, char *buf)
+{
+	const char	*units[4] = {"B", "KiB", "MiB", "GiB"};
+	int			u;
+	double		v;
+
+	u = 0;
+	v = n;
+	while (v >= 1024 && u < 3)
+	{
+		v /= 1024;
+		u++;
+	}
+	if (v == (size_t)v)
+		snprintf(buf, 16, "%zu %s", (size_t)v, units[u]);
+	else
+		snprintf(buf, 16, "%.1f %s", v, units[u]);
+	return (buf);
+}
+
+/**
+ * @brief The measured cost per byte read into a buffer of `size` bytes (the
+ * closest measured size at or above it).
+ */
+static double	read_cost(const t_costs *c, size_t size)
+{
+	int	k;
+
+	k = 0;
+	while (k < MEASURES - 1 && ((size_t)SIZE_MIN << k) < size)
+		k++;
+	return (c->read[k]);
+}
+
+/**
+ * @brief Runs every storage model for every read size, with get_next_line
+ * (views 0) and with the view readers (views 1).
+ * @return 0, or -1 if memory allocation fails.
+ */
+static int	simulate(const t_sample *s, const t_costs *c,
+	t_sim sims[2][SIZES][ENGINES])
+{
+	t_sim	*r;
+	int		v;
+	int		k;
+	int		e;
+
+	memset(sims, 0, 2 * sizeof(*sims));
+	v = -1;
+	while (++v < 2)
+	{
+		k = -1;
+		while (++k < SIZES)
+		{
+			if (sim_list(s, SIZE_MIN << k, v, &sims[v][k][0]) == -1)
+				return (-1);
+			sim_buf(s, SIZE_MIN << k, v, &sims[v][k][1]);
+			sim_ring(s, SIZE_MIN << k, v, &sims[v][k][2]);
+			e = -1;
+			while (++e < ENGINES)
+			{
+				r = &sims[v][k][e];
+				r->reads++;
+				r->cost = r->reads * c->syscall + r->copied * c->byte
+					+ r->allocs * c->alloc + s->bytes * read_cost(c, r->peak);
+			}
+		}
+	}
+	return (0);
+}
+
+/**
+ * @brief Picks the configuration with the lowest peak memory among those
+ * costing at most TOLERANCE times the cheapest one.
+ * @return The read size index times ENGINES plus the storage index.
+ */
+static int	recommend(t_sim sims[SIZES][ENGINES])
+{
+	double	best;
+	int		pick;
+	int		i;
+
+	best = sims[0][0].cost;
+	i = -1;
+	while (++i < SIZES * ENGINES)
+		if (sims[i / ENGINES][i % ENGINES].cost < best)
+			best = sims[i / ENGINES][i % ENGINES].cost;
+	pick = -1;
+	i = -1;
+	while (++i < SIZES * ENGINES)
+	{
+		if (sims[i / ENGINES][i % ENGINES].cost > best * TOLERANCE)
+			continue ;
+		if (pick == -1 || sims[i / ENGINES][i % ENGINES].peak
+			< sims[pick / ENGINES][pick % ENGINES].peak)
+			pick = i;
+	}
+	return (pick);
+}
+
+static void	print_hist(const uint32_t *v, size_t n, const char *what)
+{
+	size_t	counts[33];
+	char	lo[16];
+	char	hi[16];
+	size_t	i;
+	int		b;
+
+	memset(counts, 0, sizeof(counts));
+	i = -1;
+	while (++i < n)
+	{
+		b = 0;
+		while (b < 32 && ((size_t)1 << (b + 1)) <= v[i])
+			b++;
+		counts[b]++;
+	}
+	printf("%s:\n", what);
+	b = -1;
+	while (++b < 33)
+		if (counts[b])
+			printf("  [%8s, %8s) %10zu %5.1f%% %.*s\n",
+				human((size_t)1 << b, lo), human((size_t)2 << b, hi),
+				counts[b], 100.0 * counts[b] / n,
+				(int)(50 * counts[b] / n), "##################################"
+				"################");
+}
+
+static int	cmp_u32(const void *a, const void *b)
+{
+	return ((*(const uint32_t *)a > *(const uint32_t *)b)
+		- (*(const uint32_t *)a < *(const uint32_t *)b));
+}
+
+/**
+ * @brief Prints the read sizes and the line lengths, with percentiles.
+ * @return 0, or -1 if memory allocation fails.
+ */
+static int	report_sample(const t_sample *s)
+{
+	uint32_t	*sorted;
+	char		b[5][16];
+	size_t		n;
+
+	n = s->n_lines;
+	sorted = malloc(n * sizeof(uint32_t));
+	if (!sorted)
+		return (-1);
+	memcpy(sorted, s->lines, n * sizeof(uint32_t));
+	qsort(sorted, n, sizeof(uint32_t), cmp_u32);
+	printf("Sampled %s in %zu reads of up to %s (%s).\n\n",
+		human(s->bytes, b[0]), s->n_reads, human(READ_SIZE, b[1]),
+		(const char *[]){"stream", "regular file"}[s->regular]);
+	print_hist(s->reads, s->n_reads, "Bytes returned per read");
+	printf("\nLines: %zu, mean %s, p50 %s, p90 %s, p99 %s, max %s\n", n,
+		human(s->bytes / n, b[0]), human(sorted[n / 2], b[1]),
+		human(sorted[n * 9 / 10], b[2]), human(sorted[n * 99 / 100], b[3]),
+		human(sorted[n - 1], b[4]));
+	print_hist(s->lines, n, "Line lengths (newline included)");
+	free(sorted);
+	return (0);
+}
+
+/**
+ * @brief The fraction of lines spanning two or more reads of `size` bytes.
+ */
+static double	spanning(const t_sample *s, size_t size)
+{
+	size_t	pos;
+	size_t	spans;
+	size_t	i;
+
+	pos = 0;
+	spans = 0;
+	i = -1;
+	while (++i < s->n_lines)
+	{
+		spans += (pos / size != (pos + s->lines[i] - 1) / size);
+		pos += s->lines[i];
+	}
+	return (100.0 * spans / s->n_lines);
+}
+
+static void	report_costs(const t_costs *c)
+{
+	char	b[16];
+	int		k;
+
+	printf("\nMeasured: syscall %.0f ns, copy %.3f ns/byte, malloc+free %.0f "
+		"ns\nRead and scan, ns/byte by buffer size (syscalls left out):\n",
+		c->syscall, c->byte, c->alloc);
+	k = -1;
+	while (++k < MEASURES)
+	{
+		printf("  %9s %6.3f", human(SIZE_MIN << k, b), c->read[k]);
+		if (k % 4 == 3 || k == MEASURES - 1)
+			printf("\n");
+	}
+}
+
+static void	report_table(const t_sample *s, t_sim sims[SIZES][ENGINES],
+	int pick, const char *what)
+{
+	char	b[16];
+	int		k;
+	int		e;
+
+	printf("\n%s, estimated ns per line (* recommended):\n", what);
+	printf("  %9s %7s %10s %10s %10s\n", "read size", "spans", g_engines[0],
+		g_engines[1], g_engines[2]);
+	k = -1;
+	while (++k < SIZES)
+	{
+		printf("  %9s %6.1f%%", human(SIZE_MIN << k, b),
+			spanning(s, SIZE_MIN << k));
+		e = -1;
+		while (++e < ENGINES)
+			printf(" %9.1f%c", sims[k][e].cost / s->n_lines,
+				" *"[k * ENGINES + e == pick]);
+		printf("\n");
+	}
+}
+
+static void	report_pick(const t_sample *s, t_sim sims[SIZES][ENGINES],
+	int pick, const char *what)
+{
+	const t_sim	*r;
+	char		b[2][16];
+
+	r = &sims[pick / ENGINES][pick % ENGINES];
+	printf("%s: -D GNL_STORAGE=%s -D BUFFER_SIZE=%d\n", what,
+		g_macros[pick % ENGINES], SIZE_MIN << (pick / ENGINES));
+	printf("  %zu reads, %zu allocations, %s moved or copied by the store, "
+		"peak %s, about %.1f ns per line\n", r->reads, r->allocs,
+		human(r->copied, b[0]), human(r->peak, b[1]), r->cost / s->n_lines);
+}
+
+/* ************************************************************************** */
+
+static int	usage(void)
+{
+	fprintf(stderr, "usage: gnl_profile [-s MiB] [file]\n");
+	return (2);
+}
+
+static int	fail(const char *what)
+{
+	perror(what);
+	return (1);
+}
+
+int	main(int argc, char **argv)
+{
+	static t_sim	sims[2][SIZES][ENGINES];
+	t_sample		s;
+	t_costs			c;
+	size_t			limit;
+	int				fd;
+
+	limit = (size_t)64 << 20;
+	if (argc > 2 && !strcmp(argv[1], "-s"))
+	{
+		limit = strtoul(argv[2], NULL, 10) << 20;
+		argv += 2;
+		argc -= 2;
+	}
+	if (argc > 2 || !limit || (argc == 2 && argv[1][0] == '-'))
+		return (usage());
+	fd = STDIN_FILENO;
+	if (argc == 2)
+		fd = open(argv[1], O_RDONLY);
+	memset(&s, 0, sizeof(s));
+	if (fd == -1 || sample(fd, limit, &s) == -1)
+		return (fail("gnl_profile"));
+	if (!s.n_lines)
+		return (printf("Nothing to read.\n"), 0);
+	measure(fd, &s, &c);
+	if (report_sample(&s) == -1 || simulate(&s, &c, sims) == -1)
+		return (fail("gnl_profile"));
+	report_costs(&c);
+	report_table(&s, sims[0], recommend(sims[0]), "get_next_line");
+	report_table(&s, sims[1], recommend(sims[1]), "Views (gnl_next_view)");
+	printf("\n");
+	report_pick(&s, sims[0], recommend(sims[0]), "Recommended");
+	report_pick(&s, sims[1], recommend(sims[1]), "With views");
+	return (free(s.lines), free(s.reads), free(s.kept), 0);
+}